@@ -0,0 +1,74 @@
+#ifndef CSR_H
+#define CSR_H
+#include <stdio.h>
+#include <stdlib.h>
+/*
+压缩稀疏行(CSR)存储：适合顶点多、边稀疏、放不进邻接矩阵的大图
+offset[i] ~ offset[i+1]-1 为顶点i的所有出边下标
+adj[e]为边e的终点，weight[e]为边e的权值
+无向图每条边存两次(i->j与j->i)
+*/
+typedef struct {
+    int numNodes,numEdges;
+    int *offset; // numNodes+1 个
+    int *adj;    // numEdges 个
+    int *weight; // numEdges 个
+} CSRGraph;
+
+void FreeCSR(CSRGraph *G) {
+    free(G->offset);
+    free(G->adj);
+    free(G->weight);
+    G->offset = G->adj = G->weight = NULL;
+    G->numNodes = G->numEdges = 0;
+}
+//由边数组(from[i],to[i],w[i])构造CSR，计数排序思想：先数每个点出度，再前缀和得到起点，最后放边 O(V+E)
+//isWuxiang为1时每条边反向再存一次
+int BuildCSR(CSRGraph *G,int numNodes,int numEdges,const int *from,const int *to,const int *w,int isWuxiang) {
+    int total = isWuxiang ? numEdges * 2 : numEdges;
+    G->numNodes = numNodes;
+    G->numEdges = total;
+    G->offset = (int*)calloc(numNodes + 1,sizeof(int));
+    G->adj = (int*)malloc(sizeof(int) * (total > 0 ? total : 1));
+    G->weight = (int*)malloc(sizeof(int) * (total > 0 ? total : 1));
+    if(!G->offset || !G->adj || !G->weight) {
+        FreeCSR(G);
+        return 0;
+    }
+    //出度
+    for(int i = 0;i < numEdges;i++) {
+        if(from[i] < 0 || from[i] >= numNodes || to[i] < 0 || to[i] >= numNodes) {
+            printf("Invalid edge (%d, %d)\n",from[i]+1,to[i]+1);
+            FreeCSR(G);
+            return 0;
+        }
+        G->offset[from[i] + 1]++;
+        if(isWuxiang) G->offset[to[i] + 1]++;
+    }
+    //前缀和
+    for(int i = 0;i < numNodes;i++) {
+        G->offset[i + 1] += G->offset[i];
+    }
+    //放边，pos为每个点下一条边要放的位置
+    int *pos = (int*)malloc(sizeof(int) * (numNodes > 0 ? numNodes : 1));
+    for(int i = 0;i < numNodes;i++) {
+        pos[i] = G->offset[i];
+    }
+    for(int i = 0;i < numEdges;i++) {
+        int e = pos[from[i]]++;
+        G->adj[e] = to[i];
+        G->weight[e] = w ? w[i] : 1;
+        if(isWuxiang) {
+            e = pos[to[i]]++;
+            G->adj[e] = from[i];
+            G->weight[e] = w ? w[i] : 1;
+        }
+    }
+    free(pos);
+    return 1;
+}
+//出度
+int OutDegreeCSR(const CSRGraph *G,int v) {
+    return G->offset[v + 1] - G->offset[v];
+}
+#endif
@@ -0,0 +1,462 @@
+#ifndef GRAPH_LOADER_H
+#define GRAPH_LOADER_H
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE // -std=c11下madvise等POSIX/BSD接口需要显式打开
+#endif
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "CSR.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+/*
+图文件加载：代替Create()里逐个scanf输入顶点和边
+1 边表文本：每行 "u v" 或 "u v w"，顶点从0编号，#或%开头的行为注释
+2 Matrix Market：%%MatrixMarket matrix coordinate real|integer|pattern general|symmetric
+  顶点从1编号，symmetric只存了下三角，加载时补上反向边；real权值四舍五入为整数
+3 二进制CSR：文件头 + offset + adj + weight，加载时mmap整个文件，数组直接指向映射内存(零拷贝)
+文本先整个映射进内存，按换行切成若干块，每块独立解析(编译时加-fopenmp则多线程并行)
+手写的数字解析代替scanf/strtol，不处理locale也不做函数调用
+*/
+
+/* 文件映射**************************************** */
+typedef struct {
+    char *data;
+    size_t length;
+    int mapped; // 1为mmap，0为malloc读入
+} MappedFile;
+
+//映射整个文件，失败返回0
+int MapFile(const char *path,MappedFile *F) {
+    F->data = NULL;
+    F->length = 0;
+    F->mapped = 0;
+#ifdef _WIN32
+    FILE *fp = fopen(path,"rb");
+    if(!fp) return 0;
+    fseek(fp,0,SEEK_END);
+    long size = ftell(fp);
+    fseek(fp,0,SEEK_SET);
+    F->data = (char*)malloc(size > 0 ? size : 1);
+    if(!F->data || fread(F->data,1,size,fp) != (size_t)size) {
+        free(F->data);
+        F->data = NULL;
+        fclose(fp);
+        return 0;
+    }
+    F->length = size;
+    fclose(fp);
+    return 1;
+#else
+    int fd = open(path,O_RDONLY);
+    if(fd < 0) return 0;
+    struct stat st;
+    if(fstat(fd,&st) != 0) {
+        close(fd);
+        return 0;
+    }
+    F->length = (size_t)st.st_size;
+    if(F->length == 0) {
+        close(fd);
+        F->data = (char*)malloc(1);
+        return F->data != NULL;
+    }
+    //MAP_PRIVATE写时复制：映射可当普通数组改，不会改到文件
+    void *p = mmap(NULL,F->length,PROT_READ | PROT_WRITE,MAP_PRIVATE,fd,0);
+    close(fd);
+    if(p == MAP_FAILED) return 0;
+#ifdef MADV_SEQUENTIAL //本头文件不是第一个include时特性宏可能没生效
+    madvise(p,F->length,MADV_SEQUENTIAL);
+#endif
+    F->data = (char*)p;
+    F->mapped = 1;
+    return 1;
+#endif
+}
+
+void UnmapFile(MappedFile *F) {
+#ifndef _WIN32
+    if(F->mapped) munmap(F->data,F->length);
+    else
+#endif
+    free(F->data);
+    F->data = NULL;
+    F->length = 0;
+}
+
+/* 数字解析**************************************** */
+//跳过空格和制表符(不跳换行)
+const char* SkipBlank(const char *p,const char *end) {
+    while(p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    return p;
+}
+
+const char* SkipLine(const char *p,const char *end) {
+    const char *q = (const char*)memchr(p,'\n',end - p);
+    return q ? q + 1 : end;
+}
+//非负整数，没有数字或超过INT_MAX返回NULL(数字串过长时不让long long溢出绕回合法编号)
+const char* ParseInt(const char *p,const char *end,long long *value) {
+    long long v = 0;
+    const char *begin = p;
+    while(p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p - '0');
+        if(v > INT_MAX) return NULL;
+        p++;
+    }
+    *value = v;
+    return p == begin ? NULL : p;
+}
+//带符号小数，支持 -1.5 3e2 这类写法
+const char* ParseReal(const char *p,const char *end,double *value) {
+    int neg = 0,digits = 0;
+    if(p < end && (*p == '-' || *p == '+')) neg = *p++ == '-';
+    double v = 0;
+    while(p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p++ - '0');
+        digits++;
+    }
+    if(p < end && *p == '.') {
+        double scale = 0.1;
+        for(p++;p < end && *p >= '0' && *p <= '9';p++,digits++) {
+            v += (*p - '0') * scale;
+            scale *= 0.1;
+        }
+    }
+    if(!digits) return NULL;
+    if(p < end && (*p == 'e' || *p == 'E')) {
+        int eneg = 0;
+        long long e;
+        p++;
+        if(p < end && (*p == '-' || *p == '+')) eneg = *p++ == '-';
+        p = ParseInt(p,end,&e);
+        if(!p) return NULL;
+        if(e > 400) e = 400; //超过double范围后结果已是inf或0，不必再循环
+        while(e-- > 0) v = eneg ? v / 10 : v * 10;
+    }
+    *value = neg ? -v : v;
+    return p;
+}
+
+/* 分块解析边*************************************** */
+typedef struct {
+    int *from,*to,*w;
+    int count;
+    int maxId; // 出现过的最大顶点编号(已减去base)
+    int hasWeight;
+} EdgeBuffer;
+
+void FreeEdgeBuffer(EdgeBuffer *B) {
+    free(B->from);
+    free(B->to);
+    free(B->w);
+    B->from = B->to = B->w = NULL;
+    B->count = 0;
+}
+
+typedef struct {
+    const char *begin,*end;
+    int first; // 这一块的边从第几条开始写
+    int count,maxId,bad,badLine,hasWeight;
+} Chunk;
+
+//解析一块：每行 "u v [w]"，顶点编号减去base，结果写到B的第C->first条开始
+void ParseChunk(Chunk *C,int base,EdgeBuffer *B) {
+    const char *p = C->begin,*end = C->end;
+    int k = C->first,line = 0;
+    C->count = 0;
+    C->maxId = -1;
+    C->bad = 0;
+    C->hasWeight = 0;
+    while(p < end) {
+        line++;
+        p = SkipBlank(p,end);
+        if(p == end) break;
+        if(*p == '\n' || *p == '#' || *p == '%') {
+            p = SkipLine(p,end);
+            continue;
+        }
+        long long u,v;
+        double w = 1;
+        const char *q = ParseInt(p,end,&u);
+        if(q) q = ParseInt(SkipBlank(q,end),end,&v);
+        if(!q || u < base || v < base || u - base >= 0x7fffffff || v - base >= 0x7fffffff) {
+            if(!C->bad++) C->badLine = line;
+            p = SkipLine(p,end);
+            continue;
+        }
+        q = SkipBlank(q,end);
+        if(q < end && *q != '\n') {
+            const char *r = ParseReal(q,end,&w);
+            if(r) {
+                C->hasWeight = 1;
+                q = r;
+            }
+        }
+        B->from[k] = (int)(u - base);
+        B->to[k] = (int)(v - base);
+        B->w[k] = (int)(w < 0 ? w - 0.5 : w + 0.5);
+        if(B->from[k] > C->maxId) C->maxId = B->from[k];
+        if(B->to[k] > C->maxId) C->maxId = B->to[k];
+        k++;
+        C->count++;
+        p = SkipLine(q,end);
+    }
+}
+
+int CountLines(const char *p,const char *end) {
+    int n = 0;
+    while((p = (const char*)memchr(p,'\n',end - p)) != NULL) {
+        n++;
+        p++;
+    }
+    return n;
+}
+
+//把text解析成边数组。按换行切成多块，先各自数行数定下写入位置，再并行解析，最后把各块结果挪到一起
+int ParseEdges(const char *text,size_t length,int base,EdgeBuffer *B) {
+    const char *end = text + length;
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    int numChunks = length < (1 << 20) ? 1 : threads * 4;
+    Chunk *chunk = (Chunk*)malloc(sizeof(Chunk) * numChunks);
+    if(!chunk) return 0;
+    //切块，每块的边界移到下一个换行之后
+    const char *p = text;
+    for(int i = 0;i < numChunks;i++) {
+        const char *q = i == numChunks - 1 ? end : text + length / numChunks * (i + 1);
+        if(q < p) q = p;
+        if(q < end && q > text && q[-1] != '\n') q = SkipLine(q,end);
+        chunk[i].begin = p;
+        chunk[i].end = q;
+        p = q;
+    }
+    //每块最多 行数+1 条边
+    #pragma omp parallel for schedule(dynamic,1)
+    for(int i = 0;i < numChunks;i++) {
+        chunk[i].count = CountLines(chunk[i].begin,chunk[i].end) + 1;
+    }
+    long long total = 0;
+    for(int i = 0;i < numChunks;i++) {
+        chunk[i].first = (int)total;
+        total += chunk[i].count;
+    }
+    if(total >= 0x7fffffff) {
+        printf("Too many edges\n");
+        free(chunk);
+        return 0;
+    }
+    B->from = (int*)malloc(sizeof(int) * total);
+    B->to = (int*)malloc(sizeof(int) * total);
+    B->w = (int*)malloc(sizeof(int) * total);
+    if(!B->from || !B->to || !B->w) {
+        FreeEdgeBuffer(B);
+        free(chunk);
+        return 0;
+    }
+    #pragma omp parallel for schedule(dynamic,1)
+    for(int i = 0;i < numChunks;i++) {
+        ParseChunk(&chunk[i],base,B);
+    }
+    //合并
+    int count = 0,bad = 0;
+    B->maxId = -1;
+    B->hasWeight = 0;
+    for(int i = 0;i < numChunks;i++) {
+        if(chunk[i].bad && !bad) {
+            printf("Invalid line %d in chunk %d\n",chunk[i].badLine,i);
+        }
+        bad += chunk[i].bad;
+        if(chunk[i].first != count) {
+            memmove(B->from + count,B->from + chunk[i].first,sizeof(int) * chunk[i].count);
+            memmove(B->to + count,B->to + chunk[i].first,sizeof(int) * chunk[i].count);
+            memmove(B->w + count,B->w + chunk[i].first,sizeof(int) * chunk[i].count);
+        }
+        count += chunk[i].count;
+        if(chunk[i].maxId > B->maxId) B->maxId = chunk[i].maxId;
+        B->hasWeight |= chunk[i].hasWeight;
+    }
+    B->count = count;
+    free(chunk);
+    if(bad) {
+        FreeEdgeBuffer(B);
+        return 0;
+    }
+    return 1;
+}
+
+/* 边表与Matrix Market***************************** */
+//边表文本，顶点数为最大编号+1(numNodes更大时以numNodes为准)
+int LoadEdgeList(const char *path,CSRGraph *G,int numNodes,int isWuxiang) {
+    MappedFile F;
+    EdgeBuffer B;
+    if(!MapFile(path,&F)) {
+        printf("Cannot open %s\n",path);
+        return 0;
+    }
+    int ok = ParseEdges(F.data,F.length,0,&B);
+    UnmapFile(&F);
+    if(!ok) return 0;
+    if(B.maxId + 1 > numNodes) numNodes = B.maxId + 1;
+    ok = BuildCSR(G,numNodes,B.count,B.from,B.to,B.w,isWuxiang);
+    FreeEdgeBuffer(&B);
+    return ok;
+}
+
+int StartsWith(const char *p,const char *end,const char *word) {
+    size_t n = strlen(word);
+    return (size_t)(end - p) >= n && memcmp(p,word,n) == 0;
+}
+//在一行[p,end)中找单词(不区分大小写)
+int LineHas(const char *p,const char *end,const char *word) {
+    size_t n = strlen(word);
+    for(;p + n <= end;p++) {
+        size_t i = 0;
+        while(i < n && (p[i] | 32) == word[i]) i++;
+        if(i == n) return 1;
+    }
+    return 0;
+}
+
+int LoadMatrixMarket(const char *path,CSRGraph *G) {
+    MappedFile F;
+    if(!MapFile(path,&F)) {
+        printf("Cannot open %s\n",path);
+        return 0;
+    }
+    const char *p = F.data,*end = F.data + F.length;
+    const char *lineEnd = (const char*)memchr(p,'\n',end - p);
+    if(!lineEnd) lineEnd = end;
+    if(!StartsWith(p,end,"%%MatrixMarket") || !LineHas(p,lineEnd,"coordinate")) {
+        printf("%s: not a coordinate Matrix Market file\n",path);
+        UnmapFile(&F);
+        return 0;
+    }
+    int symmetric = LineHas(p,lineEnd,"symmetric"); // 含skew-symmetric，只关心结构
+    //跳过注释，读 行数 列数 非零元数
+    p = SkipLine(p,end);
+    while(p < end && *p == '%') p = SkipLine(p,end);
+    long long rows,cols,nnz;
+    const char *q = ParseInt(SkipBlank(p,end),end,&rows);
+    if(q) q = ParseInt(SkipBlank(q,end),end,&cols);
+    if(q) q = ParseInt(SkipBlank(q,end),end,&nnz);
+    if(!q) {
+        printf("%s: bad size line\n",path);
+        UnmapFile(&F);
+        return 0;
+    }
+    p = SkipLine(q,end);
+    EdgeBuffer B;
+    int ok = ParseEdges(p,end - p,1,&B);
+    UnmapFile(&F);
+    if(!ok) return 0;
+    if(B.count != nnz) printf("%s: expected %lld entries, read %d\n",path,nnz,B.count);
+    int numNodes = (int)(rows > cols ? rows : cols);
+    if(B.maxId + 1 > numNodes) numNodes = B.maxId + 1;
+    if(symmetric) {
+        //补上非对角元的反向边
+        int extra = 0;
+        for(int i = 0;i < B.count;i++) extra += B.from[i] != B.to[i];
+        int *from = (int*)realloc(B.from,sizeof(int) * (B.count + extra));
+        if(from) B.from = from;
+        int *to = (int*)realloc(B.to,sizeof(int) * (B.count + extra));
+        if(to) B.to = to;
+        int *w = (int*)realloc(B.w,sizeof(int) * (B.count + extra));
+        if(w) B.w = w;
+        if(!from || !to || !w) {
+            FreeEdgeBuffer(&B);
+            return 0;
+        }
+        int k = B.count;
+        for(int i = 0;i < B.count;i++) {
+            if(B.from[i] == B.to[i]) continue;
+            B.from[k] = B.to[i];
+            B.to[k] = B.from[i];
+            B.w[k] = B.w[i];
+            k++;
+        }
+        B.count = k;
+    }
+    ok = BuildCSR(G,numNodes,B.count,B.from,B.to,B.w,0);
+    FreeEdgeBuffer(&B);
+    return ok;
+}
+
+/* 二进制CSR*************************************** */
+//文件头之后依次为 offset[numNodes+1] adj[numEdges] weight[numEdges]，int按本机字节序
+typedef struct {
+    char magic[4]; // "CSRB"
+    int version;
+    int numNodes,numEdges;
+} CSRFileHeader;
+
+int SaveBinaryCSR(const char *path,const CSRGraph *G) {
+    FILE *fp = fopen(path,"wb");
+    if(!fp) {
+        printf("Cannot write %s\n",path);
+        return 0;
+    }
+    CSRFileHeader h = {{'C','S','R','B'},1,G->numNodes,G->numEdges};
+    int ok = fwrite(&h,sizeof(h),1,fp) == 1 &&
+             fwrite(G->offset,sizeof(int),G->numNodes + 1,fp) == (size_t)G->numNodes + 1 &&
+             fwrite(G->adj,sizeof(int),G->numEdges,fp) == (size_t)G->numEdges &&
+             fwrite(G->weight,sizeof(int),G->numEdges,fp) == (size_t)G->numEdges;
+    ok = fclose(fp) == 0 && ok;
+    return ok;
+}
+
+//映射后的图，G的三个数组指向File内部，不能用FreeCSR释放
+typedef struct {
+    CSRGraph G;
+    MappedFile File;
+} MappedCSR;
+
+int MapBinaryCSR(const char *path,MappedCSR *M) {
+    if(!MapFile(path,&M->File)) {
+        printf("Cannot open %s\n",path);
+        return 0;
+    }
+    CSRFileHeader h;
+    int ok = M->File.length >= sizeof(h);
+    if(ok) {
+        memcpy(&h,M->File.data,sizeof(h));
+        ok = memcmp(h.magic,"CSRB",4) == 0 && h.version == 1 && h.numNodes >= 0 && h.numEdges >= 0 &&
+             M->File.length == sizeof(h) + sizeof(int) * ((size_t)h.numNodes + 1 + 2 * (size_t)h.numEdges);
+    }
+    if(ok) {
+        M->G.numNodes = h.numNodes;
+        M->G.numEdges = h.numEdges;
+        M->G.offset = (int*)(M->File.data + sizeof(h));
+        M->G.adj = M->G.offset + h.numNodes + 1;
+        M->G.weight = M->G.adj + h.numEdges;
+        ok = M->G.offset[0] == 0 && M->G.offset[h.numNodes] == h.numEdges;
+    }
+    //文件内容不可信：O(V+E)检查offset单调、邻接点编号在[0,n)内，之后遍历才不会越界
+    for(int v = 0;ok && v < h.numNodes;v++)
+        ok = M->G.offset[v] <= M->G.offset[v + 1];
+    for(int e = 0;ok && e < h.numEdges;e++)
+        ok = M->G.adj[e] >= 0 && M->G.adj[e] < h.numNodes;
+    if(!ok) {
+        printf("%s: bad binary CSR file\n",path);
+        UnmapFile(&M->File);
+        return 0;
+    }
+    return 1;
+}
+
+void UnmapBinaryCSR(MappedCSR *M) {
+    UnmapFile(&M->File);
+    M->G.offset = M->G.adj = M->G.weight = NULL;
+    M->G.numNodes = M->G.numEdges = 0;
+}
+#endif
@@ -0,0 +1,72 @@
+#ifndef SCC_H
+#define SCC_H
+#include <stdlib.h>
+#include "CSR.h"
+/*
+有向图强连通分量(Tarjan)：一次DFS，显式栈，O(V+E)
+low[u]==dfn[u]时SCC栈中u以上的点为一个SCC；先弹出的SCC没有出边指向未弹出的SCC，
+即逆拓扑序，反过来编号后SCC编号就是缩点图(DAG)的拓扑序
+*/
+//comp[i]为顶点i所属SCC编号(0开始，已转为拓扑序)，返回SCC个数，内存不足返回-1
+int TarjanSCC(const CSRGraph *G,int *comp) {
+    int n = G->numNodes;
+    int size = n > 0 ? n : 1;
+    int *dfn = (int*)calloc(size,sizeof(int));
+    int *low = (int*)malloc(sizeof(int) * size);
+    int *it = (int*)malloc(sizeof(int) * size);
+    int *stack = (int*)malloc(sizeof(int) * size); // DFS栈
+    int *sstack = (int*)malloc(sizeof(int) * size); // SCC栈
+    char *inStack = (char*)calloc(size,1);
+    int index = 0,count = 0;
+    if(!dfn || !low || !it || !stack || !sstack || !inStack) {
+        free(dfn); free(low); free(it); free(stack); free(sstack); free(inStack);
+        return -1;
+    }
+    for(int root = 0;root < n;root++) {
+        if(dfn[root]) continue;
+        int top = 0,stop = 0;
+        dfn[root] = low[root] = ++index;
+        it[root] = G->offset[root];
+        stack[top++] = root;
+        sstack[stop++] = root;
+        inStack[root] = 1;
+        while(top > 0) {
+            int u = stack[top - 1];
+            if(it[u] < G->offset[u + 1]) {
+                int v = G->adj[it[u]++];
+                if(dfn[v] == 0) {
+                    dfn[v] = low[v] = ++index;
+                    it[v] = G->offset[v];
+                    stack[top++] = v;
+                    sstack[stop++] = v;
+                    inStack[v] = 1;
+                } else if(inStack[v] && dfn[v] < low[u]) {
+                    low[u] = dfn[v];
+                }
+            } else {
+                top--;
+                //u是SCC的根，弹出SCC
+                if(low[u] == dfn[u]) {
+                    int w;
+                    do {
+                        w = sstack[--stop];
+                        inStack[w] = 0;
+                        comp[w] = count;
+                    } while(w != u);
+                    count++;
+                }
+                if(top > 0) {
+                    int p = stack[top - 1];
+                    if(low[u] < low[p]) low[p] = low[u];
+                }
+            }
+        }
+    }
+    //Tarjan先弹出的SCC没有出边指向未弹出的SCC，即逆拓扑序，反转编号
+    for(int i = 0;i < n;i++) {
+        comp[i] = count - 1 - comp[i];
+    }
+    free(dfn); free(low); free(it); free(stack); free(sstack); free(inStack);
+    return count;
+}
+#endif
@@ -1,4 +1,5 @@
 //判断是否是关节点
+//删点后重数连通分量，判断所有点需O(V(V+E))，一次求出所有关节点、桥见 进阶补充题/关节点与桥(Tarjan非递归).c
 Status visited[MAX];
 
 void DFS(MGraph G,int i,int skip) {
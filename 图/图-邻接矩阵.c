@@ -403,6 +403,7 @@ Status isRootTreeBFS(MGraph G,int root) {
 //设计算法以求出距离顶点v0的最短路径长度（以弧数为单位）为最长的顶点, 并要求时间尽可能地少。
 //(1) 若要求输出满足条件的所有结点, 是否可通过在本算法中简单加些操作来实现？如何设计？
 //(2) 设计算法求出一棵树中层次数最大（小）的叶子结点。
+//大图的直径、半径与偏心距见 进阶补充题/直径与偏心距(iFUB 位并行多源BFS).c
 int Farest(MGraph G) {
     Queue Q;
     Init(&Q);
@@ -606,6 +607,7 @@ void Kruskal(MGraph G,Edge edge[]) {
 //然后找初点能通过一条边就到达的点们，比较权值与现有表格中的大小，若更小则更新，否则不动，
 //完成一次循环后，选出一列最小数对应的顶点，纳入最短路径的点（纳入后不再参与下面循环），
 //如此反复最后得到纳入最短路径的点按顺序走就是最短路径
+//只求两点间最短路时的双向Dijkstra、A*与ALT见 进阶补充题/点对点最短路(双向Dijkstra A* ALT).c
 int pathArc[MAXVEX];
 int shortPath[MAXVEX];
 void printPath(int v0,int v) {
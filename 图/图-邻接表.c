@@ -321,6 +321,7 @@ void CriticalPath(GraphAd G) {
 }
 //设计算法输出其所有边或弧
 //设计算法以判断顶点vi到vj之间是否存在路径
+//大量重复查询时先建可达性索引，见 进阶补充题/可达性索引(缩点 2-hop标签).c
 //设计算法以判断无向图是否是连通的
 //设计算法产生dfs(1)的生成树，并存储到邻接矩阵中；
 
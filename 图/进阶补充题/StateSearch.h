@@ -0,0 +1,439 @@
+#ifndef STATE_SEARCH_H
+#define STATE_SEARCH_H
+#include <stdio.h>
+#include <stdlib.h>
+/*
+通用状态空间搜索：BFS、双向BFS、A*、IDA*
+倒水问题(BFS).cpp每个状态都拷贝一份string路径，走迷宫.c递归Update，都是一题一写
+这里状态统一压成64位整数StateKey(由具体问题决定怎么编码)
+  已访问集合：开放定址哈希表，key -> 结点下标
+  结点池：key、父结点下标、代价g、动作，路径靠父指针回溯，不再每个状态拷贝路径
+  BFS的结点池本身就是队列(结点按入队顺序追加)
+  IDA*只保存当前路径，内存O(深度*分支数)
+具体问题只需实现Problem中的回调
+*/
+typedef unsigned long long StateKey;
+
+typedef struct {
+    //生成s的所有后继，写入next[]、cost[]、action[]，返回后继个数(不超过maxBranch)
+    int (*expand)(StateKey s,StateKey *next,int *cost,int *action,void *ctx);
+    //是否为目标(BFS、A*、IDA*使用)
+    int (*isGoal)(StateKey s,void *ctx);
+    //估价函数h(s)，不能高估(A*、IDA*使用)
+    int (*heuristic)(StateKey s,void *ctx);
+    //生成s的所有前驱(双向BFS使用，可逆问题直接填expand)，action填从前驱走到s的动作
+    int (*expandBack)(StateKey s,StateKey *prev,int *cost,int *action,void *ctx);
+    int maxBranch;
+    void *ctx;
+} Problem;
+
+typedef struct {
+    StateKey *states; // 起点到终点的状态序列
+    int *actions; // actions[i]为states[i]到states[i+1]的动作
+    int length; // 状态个数，0表示无解
+    long long cost;
+    long long expanded; // 展开的结点数
+    long long stored; // 结点池中的结点数(内存)
+} SearchPath;
+
+void FreePath(SearchPath *P) {
+    free(P->states);
+    free(P->actions);
+    P->states = NULL;
+    P->actions = NULL;
+    P->length = 0;
+}
+
+/* 结点池+哈希表************************************ */
+typedef struct {
+    StateKey *key;
+    int *parent,*action;
+    long long *g;
+    int size,capacity;
+    int *table; // 存结点下标+1，0为空
+    unsigned int mask; // 表长-1(2的幂)
+} NodePool;
+
+unsigned long long HashKey(StateKey x) {
+    //splitmix64
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+int InitPool(NodePool *N,int capacity) {
+    if(capacity < 16) capacity = 16;
+    N->size = 0;
+    N->capacity = capacity;
+    N->key = (StateKey*)malloc(sizeof(StateKey) * capacity);
+    N->parent = (int*)malloc(sizeof(int) * capacity);
+    N->action = (int*)malloc(sizeof(int) * capacity);
+    N->g = (long long*)malloc(sizeof(long long) * capacity);
+    unsigned int t = 16;
+    while(t < (unsigned int)capacity * 2) t <<= 1;
+    N->mask = t - 1;
+    N->table = (int*)calloc(t,sizeof(int));
+    return N->key && N->parent && N->action && N->g && N->table;
+}
+
+void FreePool(NodePool *N) {
+    free(N->key);
+    free(N->parent);
+    free(N->action);
+    free(N->g);
+    free(N->table);
+}
+//查找key，返回结点下标，不存在返回-1
+int FindNode(const NodePool *N,StateKey key) {
+    unsigned int i = (unsigned int)HashKey(key) & N->mask;
+    while(N->table[i]) {
+        if(N->key[N->table[i] - 1] == key) return N->table[i] - 1;
+        i = (i + 1) & N->mask;
+    }
+    return -1;
+}
+//表满一半时扩容并重新散列
+int GrowPool(NodePool *N) {
+    int capacity = N->capacity * 2;
+    StateKey *key = (StateKey*)realloc(N->key,sizeof(StateKey) * capacity);
+    if(key) N->key = key;
+    int *parent = (int*)realloc(N->parent,sizeof(int) * capacity);
+    if(parent) N->parent = parent;
+    int *action = (int*)realloc(N->action,sizeof(int) * capacity);
+    if(action) N->action = action;
+    long long *g = (long long*)realloc(N->g,sizeof(long long) * capacity);
+    if(g) N->g = g;
+    unsigned int t = (N->mask + 1) * 2;
+    int *table = (int*)calloc(t,sizeof(int));
+    if(!key || !parent || !action || !g || !table) {
+        free(table);
+        return 0;
+    }
+    N->capacity = capacity;
+    free(N->table);
+    N->table = table;
+    N->mask = t - 1;
+    for(int k = 0;k < N->size;k++) {
+        unsigned int i = (unsigned int)HashKey(N->key[k]) & N->mask;
+        while(N->table[i]) i = (i + 1) & N->mask;
+        N->table[i] = k + 1;
+    }
+    return 1;
+}
+//新增结点，返回下标，内存不足返回-1
+int AddNode(NodePool *N,StateKey key,int parent,int action,long long g) {
+    if(N->size == N->capacity && !GrowPool(N)) return -1;
+    int k = N->size++;
+    N->key[k] = key;
+    N->parent[k] = parent;
+    N->action[k] = action;
+    N->g[k] = g;
+    unsigned int i = (unsigned int)HashKey(key) & N->mask;
+    while(N->table[i]) i = (i + 1) & N->mask;
+    N->table[i] = k + 1;
+    return k;
+}
+//由父指针回溯出路径
+void BuildPath(const NodePool *N,int k,SearchPath *P) {
+    int length = 0;
+    for(int i = k;i != -1;i = N->parent[i]) length++;
+    P->states = (StateKey*)malloc(sizeof(StateKey) * length);
+    P->actions = (int*)malloc(sizeof(int) * length);
+    P->length = length;
+    P->cost = N->g[k];
+    for(int i = k,j = length - 1;i != -1;i = N->parent[i],j--) {
+        P->states[j] = N->key[i];
+        //动作记在到达的结点上，挪到前一个状态
+        if(j > 0) P->actions[j - 1] = N->action[i];
+    }
+    P->actions[length - 1] = -1;
+}
+
+void InitPath(SearchPath *P) {
+    P->states = NULL;
+    P->actions = NULL;
+    P->length = 0;
+    P->cost = 0;
+    P->expanded = 0;
+    P->stored = 0;
+}
+
+/* BFS(每步代价视为1)******************************* */
+int SearchBFS(const Problem *Pr,StateKey start,SearchPath *P) {
+    InitPath(P);
+    NodePool N;
+    if(!InitPool(&N,1024)) return 0;
+    StateKey *next = (StateKey*)malloc(sizeof(StateKey) * Pr->maxBranch);
+    int *cost = (int*)malloc(sizeof(int) * Pr->maxBranch);
+    int *action = (int*)malloc(sizeof(int) * Pr->maxBranch);
+    AddNode(&N,start,-1,-1,0);
+    int found = Pr->isGoal(start,Pr->ctx) ? 0 : -1;
+    //结点池就是队列，front为队头
+    for(int front = 0;found == -1 && front < N.size;front++) {
+        P->expanded++;
+        int count = Pr->expand(N.key[front],next,cost,action,Pr->ctx);
+        for(int i = 0;i < count;i++) {
+            if(FindNode(&N,next[i]) != -1) continue;
+            int k = AddNode(&N,next[i],front,action[i],N.g[front] + 1);
+            if(k == -1) break;
+            if(Pr->isGoal(next[i],Pr->ctx)) {
+                found = k;
+                break;
+            }
+        }
+    }
+    if(found != -1) BuildPath(&N,found,P);
+    P->stored = N.size;
+    FreePool(&N);
+    free(next);
+    free(cost);
+    free(action);
+    return found != -1;
+}
+
+/* 双向BFS(需要明确的目标状态goal)****************** */
+//两边各一个结点池，每次扩展结点较少的一边的一整层，相遇时拼接路径
+int SearchBiBFS(const Problem *Pr,StateKey start,StateKey goal,SearchPath *P) {
+    InitPath(P);
+    if(start == goal) {
+        P->states = (StateKey*)malloc(sizeof(StateKey));
+        P->actions = (int*)malloc(sizeof(int));
+        P->states[0] = start;
+        P->actions[0] = -1;
+        P->length = 1;
+        return 1;
+    }
+    NodePool F,B;
+    if(!InitPool(&F,1024) || !InitPool(&B,1024)) return 0;
+    StateKey *next = (StateKey*)malloc(sizeof(StateKey) * Pr->maxBranch);
+    int *cost = (int*)malloc(sizeof(int) * Pr->maxBranch);
+    int *action = (int*)malloc(sizeof(int) * Pr->maxBranch);
+    AddNode(&F,start,-1,-1,0);
+    AddNode(&B,goal,-1,-1,0);
+    int frontF = 0,frontB = 0,meetF = -1,meetB = -1;
+    while(meetF == -1 && frontF < F.size && frontB < B.size) {
+        int forward = (F.size - frontF) <= (B.size - frontB);
+        NodePool *X = forward ? &F : &B,*Y = forward ? &B : &F;
+        int *front = forward ? &frontF : &frontB;
+        int levelEnd = X->size;
+        for(;meetF == -1 && *front < levelEnd;(*front)++) {
+            int u = *front;
+            P->expanded++;
+            int count = forward ? Pr->expand(X->key[u],next,cost,action,Pr->ctx)
+                                : Pr->expandBack(X->key[u],next,cost,action,Pr->ctx);
+            for(int i = 0;i < count;i++) {
+                if(FindNode(X,next[i]) != -1) continue;
+                int k = AddNode(X,next[i],u,action[i],X->g[u] + 1);
+                if(k == -1) break;
+                int other = FindNode(Y,next[i]);
+                if(other != -1) {
+                    meetF = forward ? k : other;
+                    meetB = forward ? other : k;
+                    break;
+                }
+            }
+        }
+    }
+    if(meetF != -1) {
+        //正向部分 start..meet
+        SearchPath head;
+        BuildPath(&F,meetF,&head);
+        int tailLength = 0;
+        for(int i = meetB;i != -1;i = B.parent[i]) tailLength++;
+        P->length = head.length + tailLength - 1;
+        P->states = (StateKey*)malloc(sizeof(StateKey) * P->length);
+        P->actions = (int*)malloc(sizeof(int) * P->length);
+        for(int i = 0;i < head.length;i++) {
+            P->states[i] = head.states[i];
+            P->actions[i] = head.actions[i];
+        }
+        //反向部分 meet..goal，B中结点的action是从该结点走向其父结点的动作
+        int j = head.length - 1;
+        for(int i = meetB;B.parent[i] != -1;i = B.parent[i]) {
+            P->actions[j] = B.action[i];
+            P->states[++j] = B.key[B.parent[i]];
+        }
+        P->actions[P->length - 1] = -1;
+        P->cost = P->length - 1;
+        FreePath(&head);
+    }
+    P->stored = F.size + B.size;
+    FreePool(&F);
+    FreePool(&B);
+    free(next);
+    free(cost);
+    free(action);
+    return meetF != -1;
+}
+
+/* A*************************************************** */
+typedef struct {
+    long long f;
+    int node;
+} OpenItem;
+
+typedef struct {
+    OpenItem *data;
+    int size,capacity;
+} OpenHeap;
+// 上浮
+int PushOpen(OpenHeap *h,long long f,int node) {
+    if(h->size == h->capacity) {
+        int capacity = h->capacity ? h->capacity * 2 : 1024;
+        OpenItem *data = (OpenItem*)realloc(h->data,sizeof(OpenItem) * capacity);
+        if(!data) return 0;
+        h->data = data;
+        h->capacity = capacity;
+    }
+    int i = h->size++;
+    h->data[i].f = f;
+    h->data[i].node = node;
+    while(i > 0) {
+        int parent = (i - 1) / 2;
+        if(h->data[i].f >= h->data[parent].f) break;
+        OpenItem t = h->data[i]; h->data[i] = h->data[parent]; h->data[parent] = t;
+        i = parent;
+    }
+    return 1;
+}
+// 下沉
+OpenItem PopOpen(OpenHeap *h) {
+    OpenItem top = h->data[0];
+    h->data[0] = h->data[--h->size];
+    int i = 0;
+    while(2*i + 1 < h->size) {
+        int l = 2*i + 1,r = 2*i + 2,minChild = l;
+        if(r < h->size && h->data[r].f < h->data[l].f) minChild = r;
+        if(h->data[i].f <= h->data[minChild].f) break;
+        OpenItem t = h->data[i]; h->data[i] = h->data[minChild]; h->data[minChild] = t;
+        i = minChild;
+    }
+    return top;
+}
+//f = g + h，g变小时重新入堆(懒删除：出堆时f与当前g+h不符则丢弃)
+int SearchAStar(const Problem *Pr,StateKey start,SearchPath *P) {
+    InitPath(P);
+    NodePool N;
+    if(!InitPool(&N,1024)) return 0;
+    OpenHeap open = {NULL,0,0};
+    StateKey *next = (StateKey*)malloc(sizeof(StateKey) * Pr->maxBranch);
+    int *cost = (int*)malloc(sizeof(int) * Pr->maxBranch);
+    int *action = (int*)malloc(sizeof(int) * Pr->maxBranch);
+    int s = AddNode(&N,start,-1,-1,0);
+    PushOpen(&open,Pr->heuristic(start,Pr->ctx),s);
+    int found = -1;
+    while(open.size > 0) {
+        OpenItem top = PopOpen(&open);
+        int u = top.node;
+        if(top.f != N.g[u] + Pr->heuristic(N.key[u],Pr->ctx)) continue;
+        if(Pr->isGoal(N.key[u],Pr->ctx)) {
+            found = u;
+            break;
+        }
+        P->expanded++;
+        int count = Pr->expand(N.key[u],next,cost,action,Pr->ctx);
+        for(int i = 0;i < count;i++) {
+            long long g = N.g[u] + cost[i];
+            int k = FindNode(&N,next[i]);
+            if(k == -1) {
+                k = AddNode(&N,next[i],u,action[i],g);
+                if(k == -1) break;
+            } else if(g < N.g[k]) {
+                N.g[k] = g;
+                N.parent[k] = u;
+                N.action[k] = action[i];
+            } else {
+                continue;
+            }
+            PushOpen(&open,g + Pr->heuristic(next[i],Pr->ctx),k);
+        }
+    }
+    if(found != -1) BuildPath(&N,found,P);
+    P->stored = N.size;
+    FreePool(&N);
+    free(open.data);
+    free(next);
+    free(cost);
+    free(action);
+    return found != -1;
+}
+
+/* IDA*(迭代加深A*)********************************* */
+//非递归DFS，栈帧保存该层所有后继和当前处理到第几个；不走回父状态
+typedef struct {
+    StateKey key;
+    long long g;
+    int count,index;
+} Frame;
+
+int SearchIDAStar(const Problem *Pr,StateKey start,int maxDepth,SearchPath *P) {
+    InitPath(P);
+    int b = Pr->maxBranch;
+    Frame *stack = (Frame*)malloc(sizeof(Frame) * (maxDepth + 1));
+    StateKey *next = (StateKey*)malloc(sizeof(StateKey) * b * (maxDepth + 1));
+    int *cost = (int*)malloc(sizeof(int) * b * (maxDepth + 1));
+    int *action = (int*)malloc(sizeof(int) * b * (maxDepth + 1));
+    long long bound = Pr->heuristic(start,Pr->ctx);
+    int found = -1;
+    while(found == -1) {
+        long long nextBound = -1; // 超过bound的最小f
+        int top = 0;
+        stack[0].key = start;
+        stack[0].g = 0;
+        stack[0].count = -1;
+        while(top >= 0 && found == -1) {
+            Frame *F = &stack[top];
+            if(F->count == -1) {
+                //第一次进入该结点
+                long long f = F->g + Pr->heuristic(F->key,Pr->ctx);
+                if(f > bound) {
+                    if(nextBound == -1 || f < nextBound) nextBound = f;
+                    top--;
+                    continue;
+                }
+                if(Pr->isGoal(F->key,Pr->ctx)) {
+                    found = top;
+                    break;
+                }
+                if(top == maxDepth) {
+                    top--;
+                    continue;
+                }
+                P->expanded++;
+                F->count = Pr->expand(F->key,next + top * b,cost + top * b,action + top * b,Pr->ctx);
+                F->index = 0;
+            }
+            if(F->index == F->count) {
+                top--;
+                continue;
+            }
+            int i = top * b + F->index++;
+            //不走回父状态
+            if(top > 0 && next[i] == stack[top - 1].key) continue;
+            stack[top + 1].key = next[i];
+            stack[top + 1].g = F->g + cost[i];
+            stack[top + 1].count = -1;
+            top++;
+        }
+        if(found == -1 && nextBound == -1) break; // 无解
+        bound = nextBound;
+    }
+    if(found != -1) {
+        P->length = found + 1;
+        P->states = (StateKey*)malloc(sizeof(StateKey) * P->length);
+        P->actions = (int*)malloc(sizeof(int) * P->length);
+        for(int i = 0;i <= found;i++) {
+            P->states[i] = stack[i].key;
+            P->actions[i] = i < found ? action[i * b + stack[i].index - 1] : -1;
+        }
+        P->cost = stack[found].g;
+    }
+    P->stored = maxDepth + 1;
+    free(stack);
+    free(next);
+    free(cost);
+    free(action);
+    return found != -1;
+}
+#endif
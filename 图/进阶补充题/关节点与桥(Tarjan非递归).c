@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../CSR.h"
+/*
+关节点、桥与点双连通分量-Tarjan算法(非递归)
+关节点.c与图-邻接矩阵.c中的isJoint删除一个点后重新数连通分量，一次判断O(V+E)，判断所有点O(V(V+E))
+Tarjan只需一次DFS：
+  dfn[u]为u被访问的次序，low[u]为u及其子树通过一条非树边能回到的最小dfn
+  u为关节点：u是根且有两个及以上孩子，或u不是根且存在孩子v使low[v] >= dfn[u]
+  (u,v)为桥：low[v] > dfn[u]
+  点双连通分量：访问时顶点入栈，孩子v满足low[v] >= dfn[u]时，弹栈直到v，再加上u为一个分量
+用显式栈代替递归，百万层深的图(如一条长链)也不会栈溢出，总复杂度O(V+E)
+图为无向图，CSR中每条边存两次
+*/
+typedef struct {
+    char *isCut; // isCut[i]为1表示i为关节点
+    int cutCount;
+    int *bridgeBegin,*bridgeEnd; // 桥的两个端点
+    int bridgeCount;
+    int *bccOffset; // 第k个点双连通分量的顶点为bccVertex[bccOffset[k]]~bccVertex[bccOffset[k+1]-1]
+    int *bccVertex;
+    int bccCount;
+} Biconnected;
+
+void FreeBiconnected(Biconnected *R) {
+    free(R->isCut);
+    free(R->bridgeBegin);
+    free(R->bridgeEnd);
+    free(R->bccOffset);
+    free(R->bccVertex);
+}
+
+int Tarjan(const CSRGraph *G,Biconnected *R) {
+    int n = G->numNodes;
+    int size = n > 0 ? n : 1;
+    int *dfn = (int*)calloc(size,sizeof(int)); // 0表示未访问
+    int *low = (int*)malloc(sizeof(int) * size);
+    int *parent = (int*)malloc(sizeof(int) * size);
+    int *it = (int*)malloc(sizeof(int) * size); // 当前弧，代替递归中的循环变量
+    char *skipped = (char*)calloc(size,1); // 是否已跳过回到父节点的那条边(重边时只跳过一条)
+    int *stack = (int*)malloc(sizeof(int) * size); // DFS栈
+    int *vstack = (int*)malloc(sizeof(int) * size); // 点双连通分量的顶点栈
+    R->isCut = (char*)calloc(size,1);
+    R->bridgeBegin = (int*)malloc(sizeof(int) * size);
+    R->bridgeEnd = (int*)malloc(sizeof(int) * size);
+    //每个分量至少有一个点是第一次出现，分量数不超过n；顶点总数不超过n+分量数
+    R->bccOffset = (int*)malloc(sizeof(int) * (size + 1));
+    R->bccVertex = (int*)malloc(sizeof(int) * 2 * size);
+    R->cutCount = R->bridgeCount = R->bccCount = 0;
+    if(!dfn || !low || !parent || !it || !skipped || !stack || !vstack ||
+       !R->isCut || !R->bridgeBegin || !R->bridgeEnd || !R->bccOffset || !R->bccVertex) {
+        free(dfn); free(low); free(parent); free(it); free(skipped); free(stack); free(vstack);
+        FreeBiconnected(R);
+        return 0;
+    }
+    int index = 0,bccTotal = 0;
+    R->bccOffset[0] = 0;
+    for(int root = 0;root < n;root++) {
+        if(dfn[root]) continue;
+        int top = 0,vtop = 0,rootChild = 0;
+        dfn[root] = low[root] = ++index;
+        parent[root] = -1;
+        it[root] = G->offset[root];
+        stack[top++] = root;
+        vstack[vtop++] = root;
+        while(top > 0) {
+            int u = stack[top - 1];
+            if(it[u] < G->offset[u + 1]) {
+                int v = G->adj[it[u]++];
+                if(v == parent[u] && !skipped[u]) {
+                    skipped[u] = 1;
+                    continue;
+                }
+                if(dfn[v] == 0) {
+                    //树边，相当于递归调用DFS(v)
+                    dfn[v] = low[v] = ++index;
+                    parent[v] = u;
+                    it[v] = G->offset[v];
+                    stack[top++] = v;
+                    vstack[vtop++] = v;
+                    if(u == root) rootChild++;
+                } else if(dfn[v] < low[u]) {
+                    //回边
+                    low[u] = dfn[v];
+                }
+            } else {
+                //u的边都处理完，相当于递归返回到父节点p
+                top--;
+                int p = parent[u];
+                if(p == -1) continue;
+                if(low[u] < low[p]) low[p] = low[u];
+                if(low[u] > dfn[p]) {
+                    R->bridgeBegin[R->bridgeCount] = p;
+                    R->bridgeEnd[R->bridgeCount] = u;
+                    R->bridgeCount++;
+                }
+                if(low[u] >= dfn[p]) {
+                    if(p != root && !R->isCut[p]) {
+                        R->isCut[p] = 1;
+                        R->cutCount++;
+                    }
+                    //弹出u所在子树中剩余的点，加上p组成一个点双连通分量
+                    int w;
+                    do {
+                        w = vstack[--vtop];
+                        R->bccVertex[bccTotal++] = w;
+                    } while(w != u);
+                    R->bccVertex[bccTotal++] = p;
+                    R->bccOffset[++R->bccCount] = bccTotal;
+                }
+            }
+        }
+        if(rootChild >= 2) {
+            R->isCut[root] = 1;
+            R->cutCount++;
+        }
+        //孤立点单独成一个分量
+        if(rootChild == 0) {
+            R->bccVertex[bccTotal++] = root;
+            R->bccOffset[++R->bccCount] = bccTotal;
+        }
+    }
+    free(dfn); free(low); free(parent); free(it); free(skipped); free(stack); free(vstack);
+    return 1;
+}
+//与isJoint相同的接口，判断顶点vex(1~n)是否为关节点
+int isJoint(Biconnected R,int vex) {
+    return R.isCut[vex - 1];
+}
+
+void PrintBiconnected(Biconnected R,int n) {
+    printf("Joint:");
+    for(int i = 0;i < n;i++) {
+        if(R.isCut[i]) printf(" %d",i+1);
+    }
+    printf("\nBridge:");
+    for(int i = 0;i < R.bridgeCount;i++) {
+        printf(" (%d,%d)",R.bridgeBegin[i]+1,R.bridgeEnd[i]+1);
+    }
+    printf("\n");
+    for(int k = 0;k < R.bccCount;k++) {
+        printf("BCC %d:",k+1);
+        for(int i = R.bccOffset[k];i < R.bccOffset[k + 1];i++) {
+            printf(" %d",R.bccVertex[i]+1);
+        }
+        printf("\n");
+    }
+}
+
+int main() {
+    /*示例图
+    1 —— 2 —— 4 —— 5
+     \  /     |    |
+      3       6 —— 7 —— 8
+    关节点 2 4 7，桥 (2,4) (7,8)
+    */
+    int from[] = {0,0,1,1,3,3,4,5,6};
+    int to[]   = {1,2,2,3,4,5,6,6,7};
+    CSRGraph G;
+    Biconnected R;
+    BuildCSR(&G,8,9,from,to,NULL,1);
+    Tarjan(&G,&R);
+    PrintBiconnected(R,8);
+    printf("Vertex 4 is joint: %s\n",isJoint(R,4) ? "YES" : "NO");
+    FreeBiconnected(&R);
+    FreeCSR(&G);
+
+    //一条长链：递归版DFS在这里会栈溢出
+    printf("\n*******\n");
+    int n = 2000000,m = n - 1;
+    int *f = (int*)malloc(sizeof(int) * m);
+    int *t = (int*)malloc(sizeof(int) * m);
+    for(int i = 0;i < m;i++) {
+        f[i] = i;
+        t[i] = i + 1;
+    }
+    BuildCSR(&G,n,m,f,t,NULL,1);
+    clock_t begin = clock();
+    Tarjan(&G,&R);
+    printf("Path V=%d joint=%d bridge=%d bcc=%d time=%.3fs\n",n,R.cutCount,R.bridgeCount,R.bccCount,(double)(clock() - begin) / CLOCKS_PER_SEC);
+    FreeBiconnected(&R);
+    FreeCSR(&G);
+    free(f);
+    free(t);
+
+    //随机稀疏图
+    n = 1000000;
+    m = 1500000;
+    f = (int*)malloc(sizeof(int) * m);
+    t = (int*)malloc(sizeof(int) * m);
+    srand(2024);
+    for(int i = 0;i < m;i++) {
+        f[i] = rand() % n;
+        t[i] = rand() % n;
+    }
+    BuildCSR(&G,n,m,f,t,NULL,1);
+    begin = clock();
+    Tarjan(&G,&R);
+    printf("Random V=%d E=%d joint=%d bridge=%d bcc=%d time=%.3fs\n",n,m,R.cutCount,R.bridgeCount,R.bccCount,(double)(clock() - begin) / CLOCKS_PER_SEC);
+    FreeBiconnected(&R);
+    FreeCSR(&G);
+    free(f);
+    free(t);
+    return 0;
+}
@@ -0,0 +1,322 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../CSR.h"
+/*
+关键路径(CPM)引擎
+图-邻接表.c中的CriticalPath依赖全局etv、全局栈S2和栈上的int ltv[MAX]，只能打印关键边，也不能同时算两张图
+这里所有状态都放在CPM结构体中(可重入)，在CSR存储的AOE网上O(V+E)求出：
+  etv[v]   事件最早发生时间 = 源点到v的最长路径
+  tail[v]  v到汇点的最长路径，事件最迟发生时间 ltv[v] = 工期total - tail[v]
+  每个活动(边)u->v：最早开始e = etv[u]，最晚开始l = ltv[v] - 持续时间，时间余量slack = l - e，为0则为关键活动
+用tail代替ltv的好处：工期变化时不用改动每个点的ltv
+增量更新：活动u->v持续时间改变时
+  etv只可能在v及其后继中变化，按拓扑序从v开始向后传播，值不变的点就不再往后走
+  tail只可能在u及其前驱中变化，按逆拓扑序从u开始向前传播
+  新工期：变长时为max(原工期, etv[u]+w+tail[v])，变短且该边原来在关键路径上时重新取各汇点etv的最大值
+*/
+#define OK 1
+#define ERROR 0
+
+typedef int Status;
+
+typedef struct {
+    const CSRGraph *G; // 不拥有，边的顺序即活动编号
+    int *dur; // 活动持续时间，初始为G->weight的拷贝
+    int *from; // 边e的起点
+    int *inOffset,*inEdge; // 入边(存边编号)，inEdge[inOffset[v]]~为指向v的边
+    int *order,*pos; // 拓扑序列，pos[v]为v在序列中的位置
+    long long *etv,*tail;
+    long long total; // 工期
+    int *sinks,sinkCount; // 出度为0的点
+    int *heap,*inHeap,heapSize; // 增量更新用的最小堆(按拓扑位置)
+    long long touched; // 上一次增量更新访问的点数
+} CPM;
+
+typedef struct {
+    int begin,end,duration;
+    long long early,late,slack;
+} Activity;
+
+void DestroyCPM(CPM *P) {
+    free(P->dur); free(P->from); free(P->inOffset); free(P->inEdge);
+    free(P->order); free(P->pos); free(P->etv); free(P->tail);
+    free(P->sinks); free(P->heap); free(P->inHeap);
+}
+//按拓扑序求etv，按逆拓扑序求tail
+void ComputeAll(CPM *P) {
+    const CSRGraph *G = P->G;
+    int n = G->numNodes;
+    for(int i = 0;i < n;i++) {
+        P->etv[i] = 0;
+        P->tail[i] = 0;
+    }
+    for(int i = 0;i < n;i++) {
+        int u = P->order[i];
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            if(P->etv[u] + P->dur[e] > P->etv[G->adj[e]]) {
+                P->etv[G->adj[e]] = P->etv[u] + P->dur[e];
+            }
+        }
+    }
+    for(int i = n - 1;i >= 0;i--) {
+        int u = P->order[i];
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            if(P->dur[e] + P->tail[G->adj[e]] > P->tail[u]) {
+                P->tail[u] = P->dur[e] + P->tail[G->adj[e]];
+            }
+        }
+    }
+    P->total = 0;
+    for(int i = 0;i < P->sinkCount;i++) {
+        if(P->etv[P->sinks[i]] > P->total) P->total = P->etv[P->sinks[i]];
+    }
+}
+//初始化并计算，有环返回ERROR
+Status InitCPM(CPM *P,const CSRGraph *G) {
+    int n = G->numNodes,m = G->numEdges;
+    int sn = n > 0 ? n : 1,sm = m > 0 ? m : 1;
+    P->G = G;
+    P->dur = (int*)malloc(sizeof(int) * sm);
+    P->from = (int*)malloc(sizeof(int) * sm);
+    P->inOffset = (int*)calloc(n + 1,sizeof(int));
+    P->inEdge = (int*)malloc(sizeof(int) * sm);
+    P->order = (int*)malloc(sizeof(int) * sn);
+    P->pos = (int*)malloc(sizeof(int) * sn);
+    P->etv = (long long*)malloc(sizeof(long long) * sn);
+    P->tail = (long long*)malloc(sizeof(long long) * sn);
+    P->sinks = (int*)malloc(sizeof(int) * sn);
+    P->heap = (int*)malloc(sizeof(int) * sn);
+    P->inHeap = (int*)calloc(sn,sizeof(int));
+    P->heapSize = 0;
+    P->sinkCount = 0;
+    P->touched = 0;
+    if(!P->dur || !P->from || !P->inOffset || !P->inEdge || !P->order || !P->pos ||
+       !P->etv || !P->tail || !P->sinks || !P->heap || !P->inHeap) {
+        DestroyCPM(P);
+        return ERROR;
+    }
+    for(int u = 0;u < n;u++) {
+        if(G->offset[u] == G->offset[u + 1]) P->sinks[P->sinkCount++] = u;
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            P->dur[e] = G->weight[e];
+            P->from[e] = u;
+            P->inOffset[G->adj[e] + 1]++;
+        }
+    }
+    //入边CSR
+    for(int i = 0;i < n;i++) P->inOffset[i + 1] += P->inOffset[i];
+    int *cur = P->pos; // 暂借pos做放边指针
+    for(int i = 0;i < n;i++) cur[i] = P->inOffset[i];
+    for(int e = 0;e < m;e++) P->inEdge[cur[G->adj[e]]++] = e;
+    //拓扑排序(Kahn)，入度借用inHeap
+    int *inDegree = P->inHeap;
+    int front = 0,rear = 0;
+    for(int i = 0;i < n;i++) {
+        inDegree[i] = P->inOffset[i + 1] - P->inOffset[i];
+        if(inDegree[i] == 0) P->order[rear++] = i;
+    }
+    while(front < rear) {
+        int u = P->order[front++];
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            if(--inDegree[G->adj[e]] == 0) P->order[rear++] = G->adj[e];
+        }
+    }
+    for(int i = 0;i < n;i++) inDegree[i] = 0;
+    //判断是否为AOE网(无环)
+    if(rear < n) {
+        DestroyCPM(P);
+        return ERROR;
+    }
+    for(int i = 0;i < n;i++) P->pos[P->order[i]] = i;
+    ComputeAll(P);
+    return OK;
+}
+
+long long GetLtv(const CPM *P,int v) {
+    return P->total - P->tail[v];
+}
+
+Status GetActivity(const CPM *P,int e,Activity *A) {
+    if(e < 0 || e >= P->G->numEdges) return ERROR;
+    int u = P->from[e],v = P->G->adj[e];
+    A->begin = u;
+    A->end = v;
+    A->duration = P->dur[e];
+    A->early = P->etv[u];
+    A->late = GetLtv(P,v) - P->dur[e];
+    A->slack = A->late - A->early;
+    return OK;
+}
+//关键活动编号存入edges，返回个数
+int CriticalActivities(const CPM *P,int *edges) {
+    int count = 0;
+    for(int e = 0;e < P->G->numEdges;e++) {
+        int u = P->from[e],v = P->G->adj[e];
+        if(P->etv[u] + P->dur[e] + P->tail[v] == P->total) edges[count++] = e;
+    }
+    return count;
+}
+
+/* 按key最小的堆，key为拓扑位置(或其相反数) */
+void HeapPush(CPM *P,int v,int sign) {
+    if(P->inHeap[v]) return;
+    P->inHeap[v] = 1;
+    int i = P->heapSize++;
+    P->heap[i] = v;
+    // 上浮
+    while(i > 0) {
+        int parent = (i - 1) / 2;
+        if(sign * P->pos[P->heap[i]] >= sign * P->pos[P->heap[parent]]) break;
+        int t = P->heap[i]; P->heap[i] = P->heap[parent]; P->heap[parent] = t;
+        i = parent;
+    }
+}
+
+int HeapPop(CPM *P,int sign) {
+    int top = P->heap[0];
+    P->inHeap[top] = 0;
+    P->heap[0] = P->heap[--P->heapSize];
+    int i = 0;
+    // 下沉
+    while(2*i + 1 < P->heapSize) {
+        int l = 2*i + 1,r = 2*i + 2,minChild = l;
+        if(r < P->heapSize && sign * P->pos[P->heap[r]] < sign * P->pos[P->heap[l]]) minChild = r;
+        if(sign * P->pos[P->heap[i]] <= sign * P->pos[P->heap[minChild]]) break;
+        int t = P->heap[i]; P->heap[i] = P->heap[minChild]; P->heap[minChild] = t;
+        i = minChild;
+    }
+    return top;
+}
+//修改活动e的持续时间，只重算受影响的点
+Status UpdateDuration(CPM *P,int e,int duration) {
+    if(e < 0 || e >= P->G->numEdges || duration < 0) return ERROR;
+    const CSRGraph *G = P->G;
+    int u = P->from[e],v = G->adj[e];
+    int old = P->dur[e];
+    int wasCritical = P->etv[u] + old + P->tail[v] == P->total;
+    P->dur[e] = duration;
+    P->touched = 0;
+    //etv从v开始按拓扑序向后传播
+    HeapPush(P,v,1);
+    while(P->heapSize > 0) {
+        int x = HeapPop(P,1);
+        P->touched++;
+        long long best = 0;
+        for(int i = P->inOffset[x];i < P->inOffset[x + 1];i++) {
+            int k = P->inEdge[i];
+            if(P->etv[P->from[k]] + P->dur[k] > best) best = P->etv[P->from[k]] + P->dur[k];
+        }
+        if(best != P->etv[x]) {
+            P->etv[x] = best;
+            for(int k = G->offset[x];k < G->offset[x + 1];k++) HeapPush(P,G->adj[k],1);
+        }
+    }
+    //tail从u开始按逆拓扑序向前传播
+    HeapPush(P,u,-1);
+    while(P->heapSize > 0) {
+        int x = HeapPop(P,-1);
+        P->touched++;
+        long long best = 0;
+        for(int k = G->offset[x];k < G->offset[x + 1];k++) {
+            if(P->dur[k] + P->tail[G->adj[k]] > best) best = P->dur[k] + P->tail[G->adj[k]];
+        }
+        if(best != P->tail[x]) {
+            P->tail[x] = best;
+            for(int i = P->inOffset[x];i < P->inOffset[x + 1];i++) HeapPush(P,P->from[P->inEdge[i]],-1);
+        }
+    }
+    //工期
+    long long through = P->etv[u] + duration + P->tail[v];
+    if(through > P->total) {
+        P->total = through;
+    } else if(duration < old && wasCritical) {
+        P->total = 0;
+        for(int i = 0;i < P->sinkCount;i++) {
+            if(P->etv[P->sinks[i]] > P->total) P->total = P->etv[P->sinks[i]];
+        }
+    }
+    return OK;
+}
+
+int main() {
+    /*示例AOE网(9个事件 11个活动)
+    1->2:6 1->3:4 1->4:5 2->5:1 3->5:1 4->6:2 5->7:9 5->8:7 6->8:4 7->9:2 8->9:4
+    工期18，关键路径 1->2->5->7->9 与 1->2->5->8->9
+    */
+    int from[] = {0,0,0,1,2,3,4,4,5,6,7};
+    int to[]   = {1,2,3,4,4,5,6,7,7,8,8};
+    int w[]    = {6,4,5,1,1,2,9,7,4,2,4};
+    CSRGraph G;
+    CPM P;
+    BuildCSR(&G,9,11,from,to,w,0);
+    InitCPM(&P,&G);
+    printf("Total %lld\n",P.total);
+    for(int e = 0;e < G.numEdges;e++) {
+        Activity A;
+        GetActivity(&P,e,&A);
+        printf("<%d-%d> dur=%d e=%lld l=%lld slack=%lld%s\n",A.begin+1,A.end+1,A.duration,A.early,A.late,A.slack,A.slack == 0 ? " *" : "");
+    }
+    //把活动4->6改为10，关键路径改变
+    int e46 = -1;
+    for(int e = G.offset[3];e < G.offset[4];e++) {
+        if(G.adj[e] == 5) e46 = e;
+    }
+    UpdateDuration(&P,e46,10);
+    int critical[11];
+    int count = CriticalActivities(&P,critical);
+    printf("After <4-6>=10 total %lld critical:",P.total);
+    for(int i = 0;i < count;i++) printf(" <%d-%d>",P.from[critical[i]]+1,G.adj[critical[i]]+1);
+    printf("\n");
+    DestroyCPM(&P);
+    FreeCSR(&G);
+
+    //大规模DAG：边只从编号小的点指向编号大的点
+    printf("\n*******\n");
+    int n = 1000000,m = 4000000;
+    int *f = (int*)malloc(sizeof(int) * m);
+    int *t = (int*)malloc(sizeof(int) * m);
+    int *d = (int*)malloc(sizeof(int) * m);
+    srand(2024);
+    for(int i = 0;i < m;i++) {
+        int a = rand() % (n - 1);
+        int b = a + 1 + rand() % 1000;
+        f[i] = a;
+        t[i] = b < n ? b : n - 1;
+        d[i] = rand() % 100 + 1;
+    }
+    BuildCSR(&G,n,m,f,t,d,0);
+    free(f);
+    free(t);
+    free(d);
+    clock_t begin = clock();
+    InitCPM(&P,&G);
+    printf("Full   V=%d E=%d total=%lld time=%.3fs\n",n,m,P.total,(double)(clock() - begin) / CLOCKS_PER_SEC);
+    begin = clock();
+    long long touched = 0;
+    int updates = 1000;
+    for(int i = 0;i < updates;i++) {
+        UpdateDuration(&P,rand() % m,rand() % 100 + 1);
+        touched += P.touched;
+    }
+    printf("Update x%d total=%lld avg touched=%lld time=%.3fs\n",updates,P.total,touched / updates,(double)(clock() - begin) / CLOCKS_PER_SEC);
+    //与从头计算对比
+    long long total = P.total;
+    long long *etv = (long long*)malloc(sizeof(long long) * n);
+    long long *tail = (long long*)malloc(sizeof(long long) * n);
+    for(int i = 0;i < n;i++) {
+        etv[i] = P.etv[i];
+        tail[i] = P.tail[i];
+    }
+    ComputeAll(&P);
+    int same = total == P.total;
+    for(int i = 0;i < n;i++) {
+        if(etv[i] != P.etv[i] || tail[i] != P.tail[i]) same = 0;
+    }
+    printf("Check %s\n",same ? "OK" : "ERROR");
+    free(etv);
+    free(tail);
+    DestroyCPM(&P);
+    FreeCSR(&G);
+    return 0;
+}
@@ -0,0 +1,309 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+/*
+动态拓扑排序-Pearce-Kelly算法
+图-邻接表.c中的TopoSort每次都重新求入度、重新排序，O(V+E)；AllTopoSort回溯枚举所有序列是指数级
+构建系统中边是一条条加入的，每加一条边都重排一次太慢
+维护ord[v]为v在拓扑序列中的位置，node[i]为位置i上的点，插入边u->v时：
+  1 若ord[u] < ord[v]，序列仍然合法，什么都不用做
+  2 否则只有位置在[ord[v],ord[u]]之间的点可能受影响(受影响区域)：
+    从v正向DFS，只走ord <= ord[u]的点，得到集合F(若走到u则成环，拒绝插入)
+    从u反向DFS，只走ord >= ord[v]的点，得到集合B
+    把B和F原来占的位置收集起来排序，先按原顺序放B，再按原顺序放F
+  只访问受影响区域，区域外的点位置不变
+*/
+#define OK 1
+#define ERROR 0
+
+typedef int Status;
+
+//每个点的出边与入边用可扩容数组存，便于在线加边
+typedef struct {
+    int *data;
+    int size,capacity;
+} IntList;
+
+typedef struct {
+    int numNodes,numEdges,capacity;
+    IntList *out,*in;
+    int *ord; // ord[v]为v在拓扑序列中的位置
+    int *node; // node[i]为位置i上的点
+    int *mark; // DFS访问标记，值为当前的stamp
+    int stamp;
+    IntList stack,deltaF,deltaB,slots; // 复用的临时数组，避免每次插入都malloc
+} DynTopo;
+
+Status ListPush(IntList *L,int x) {
+    if(L->size == L->capacity) {
+        int capacity = L->capacity ? L->capacity * 2 : 4;
+        int *data = (int*)realloc(L->data,sizeof(int) * capacity);
+        if(!data) return ERROR;
+        L->data = data;
+        L->capacity = capacity;
+    }
+    L->data[L->size++] = x;
+    return OK;
+}
+
+Status InitDynTopo(DynTopo *D,int capacity) {
+    if(capacity < 1) capacity = 1;
+    D->numNodes = D->numEdges = 0;
+    D->capacity = capacity;
+    D->out = (IntList*)calloc(capacity,sizeof(IntList));
+    D->in = (IntList*)calloc(capacity,sizeof(IntList));
+    D->ord = (int*)malloc(sizeof(int) * capacity);
+    D->node = (int*)malloc(sizeof(int) * capacity);
+    D->mark = (int*)calloc(capacity,sizeof(int));
+    D->stamp = 0;
+    D->stack.data = D->deltaF.data = D->deltaB.data = D->slots.data = NULL;
+    D->stack.size = D->deltaF.size = D->deltaB.size = D->slots.size = 0;
+    D->stack.capacity = D->deltaF.capacity = D->deltaB.capacity = D->slots.capacity = 0;
+    if(!D->out || !D->in || !D->ord || !D->node || !D->mark) return ERROR;
+    return OK;
+}
+
+void DestroyDynTopo(DynTopo *D) {
+    for(int i = 0;i < D->numNodes;i++) {
+        free(D->out[i].data);
+        free(D->in[i].data);
+    }
+    free(D->out);
+    free(D->in);
+    free(D->ord);
+    free(D->node);
+    free(D->mark);
+    free(D->stack.data);
+    free(D->deltaF.data);
+    free(D->deltaB.data);
+    free(D->slots.data);
+}
+//新点没有边，放在序列末尾，返回点的下标
+int AddVertex(DynTopo *D) {
+    if(D->numNodes == D->capacity) {
+        int capacity = D->capacity * 2;
+        IntList *out = (IntList*)realloc(D->out,sizeof(IntList) * capacity);
+        if(out) D->out = out;
+        IntList *in = (IntList*)realloc(D->in,sizeof(IntList) * capacity);
+        if(in) D->in = in;
+        int *ord = (int*)realloc(D->ord,sizeof(int) * capacity);
+        if(ord) D->ord = ord;
+        int *node = (int*)realloc(D->node,sizeof(int) * capacity);
+        if(node) D->node = node;
+        int *mark = (int*)realloc(D->mark,sizeof(int) * capacity);
+        if(mark) D->mark = mark;
+        if(!out || !in || !ord || !node || !mark) return -1;
+        D->capacity = capacity;
+    }
+    int v = D->numNodes++;
+    D->out[v].data = D->in[v].data = NULL;
+    D->out[v].size = D->in[v].size = 0;
+    D->out[v].capacity = D->in[v].capacity = 0;
+    D->ord[v] = v;
+    D->node[v] = v;
+    D->mark[v] = 0;
+    return v;
+}
+//正向DFS：从v出发只走ord<=ub的点，遇到u说明成环
+Status ForwardDFS(DynTopo *D,int v,int ub,int u) {
+    D->stack.size = 0;
+    ListPush(&D->stack,v);
+    D->mark[v] = D->stamp;
+    while(D->stack.size > 0) {
+        int x = D->stack.data[--D->stack.size];
+        ListPush(&D->deltaF,x);
+        for(int i = 0;i < D->out[x].size;i++) {
+            int y = D->out[x].data[i];
+            if(y == u) return ERROR;
+            if(D->mark[y] != D->stamp && D->ord[y] < ub) {
+                D->mark[y] = D->stamp;
+                ListPush(&D->stack,y);
+            }
+        }
+    }
+    return OK;
+}
+//反向DFS：从u出发沿入边只走ord>lb的点
+void BackwardDFS(DynTopo *D,int u,int lb) {
+    D->stack.size = 0;
+    ListPush(&D->stack,u);
+    D->mark[u] = D->stamp;
+    while(D->stack.size > 0) {
+        int x = D->stack.data[--D->stack.size];
+        ListPush(&D->deltaB,x);
+        for(int i = 0;i < D->in[x].size;i++) {
+            int y = D->in[x].data[i];
+            if(D->mark[y] != D->stamp && D->ord[y] > lb) {
+                D->mark[y] = D->stamp;
+                ListPush(&D->stack,y);
+            }
+        }
+    }
+}
+//按原位置排序
+const int *sortKey;
+int CompareOrd(const void *a,const void *b) {
+    return sortKey[*(const int*)a] - sortKey[*(const int*)b];
+}
+
+void SortByOrd(DynTopo *D,IntList *L) {
+    sortKey = D->ord;
+    qsort(L->data,L->size,sizeof(int),CompareOrd);
+}
+
+int CompareInt(const void *a,const void *b) {
+    return *(const int*)a - *(const int*)b;
+}
+//插入边u->v，成环返回ERROR且不插入
+Status InsertEdge(DynTopo *D,int u,int v) {
+    if(u < 0 || u >= D->numNodes || v < 0 || v >= D->numNodes) return ERROR;
+    if(u == v) return ERROR;
+    int lb = D->ord[v],ub = D->ord[u];
+    if(lb < ub) {
+        //v在u前面，需要重排受影响区域
+        D->stamp++;
+        D->deltaF.size = D->deltaB.size = 0;
+        if(ForwardDFS(D,v,ub,u) == ERROR) {
+            return ERROR;
+        }
+        BackwardDFS(D,u,lb);
+        SortByOrd(D,&D->deltaB);
+        SortByOrd(D,&D->deltaF);
+        //收集两个集合原来占的位置
+        D->slots.size = 0;
+        for(int i = 0;i < D->deltaB.size;i++) ListPush(&D->slots,D->ord[D->deltaB.data[i]]);
+        for(int i = 0;i < D->deltaF.size;i++) ListPush(&D->slots,D->ord[D->deltaF.data[i]]);
+        qsort(D->slots.data,D->slots.size,sizeof(int),CompareInt);
+        //先放B再放F
+        int k = 0;
+        for(int i = 0;i < D->deltaB.size;i++) {
+            int x = D->deltaB.data[i];
+            D->ord[x] = D->slots.data[k++];
+            D->node[D->ord[x]] = x;
+        }
+        for(int i = 0;i < D->deltaF.size;i++) {
+            int x = D->deltaF.data[i];
+            D->ord[x] = D->slots.data[k++];
+            D->node[D->ord[x]] = x;
+        }
+    }
+    if(ListPush(&D->out[u],v) == ERROR || ListPush(&D->in[v],u) == ERROR) return ERROR;
+    D->numEdges++;
+    return OK;
+}
+//删除边不会破坏拓扑序，序列不用动
+Status DeleteEdge(DynTopo *D,int u,int v) {
+    IntList *L = &D->out[u];
+    int i = 0;
+    while(i < L->size && L->data[i] != v) i++;
+    if(i == L->size) return ERROR;
+    L->data[i] = L->data[--L->size];
+    L = &D->in[v];
+    i = 0;
+    while(i < L->size && L->data[i] != u) i++;
+    L->data[i] = L->data[--L->size];
+    D->numEdges--;
+    return OK;
+}
+
+//对比用：每插一条边就用Kahn算法从头拓扑排序一次，与TopoSort相同
+Status TopoSortAll(DynTopo *D,int *inDegree,int *queue) {
+    for(int i = 0;i < D->numNodes;i++) inDegree[i] = D->in[i].size;
+    int front = 0,rear = 0;
+    for(int i = 0;i < D->numNodes;i++) {
+        if(inDegree[i] == 0) queue[rear++] = i;
+    }
+    while(front < rear) {
+        int u = queue[front++];
+        for(int i = 0;i < D->out[u].size;i++) {
+            if(--inDegree[D->out[u].data[i]] == 0) queue[rear++] = D->out[u].data[i];
+        }
+    }
+    return rear == D->numNodes ? OK : ERROR;
+}
+
+void PrintOrder(DynTopo *D) {
+    for(int i = 0;i < D->numNodes;i++) {
+        printf("%d ",D->node[i]+1);
+    }
+    printf("\n");
+}
+//检查当前序列是否合法
+Status CheckOrder(DynTopo *D) {
+    for(int u = 0;u < D->numNodes;u++) {
+        for(int i = 0;i < D->out[u].size;i++) {
+            if(D->ord[u] >= D->ord[D->out[u].data[i]]) return ERROR;
+        }
+    }
+    return OK;
+}
+
+int main() {
+    DynTopo D;
+    InitDynTopo(&D,4);
+    for(int i = 0;i < 6;i++) AddVertex(&D);
+    int edges[][2] = {{5,4},{4,3},{3,2},{2,1},{1,0},{0,5}};
+    for(int i = 0;i < 6;i++) {
+        Status s = InsertEdge(&D,edges[i][0],edges[i][1]);
+        printf("Insert <%d-%d> %s  order: ",edges[i][0]+1,edges[i][1]+1,s == OK ? "OK   " : "CYCLE");
+        PrintOrder(&D);
+    }
+    DestroyDynTopo(&D);
+
+    //随机DAG的边逐条插入，与每次重新拓扑排序对比
+    printf("\n*******\n");
+    int sizes[][2] = {{5000,20000},{200000,1000000}};
+    for(int k = 0;k < 2;k++) {
+        int n = sizes[k][0],m = sizes[k][1];
+        //隐藏的合法顺序，保证插入的边不成环
+        //构建目标大致按依赖顺序声明，这里在声明顺序上做局部打乱(每256个点内随机交换)
+        int *perm = (int*)malloc(sizeof(int) * n);
+        for(int i = 0;i < n;i++) perm[i] = i;
+        srand(2024);
+        for(int i = n - 1;i > 0;i--) {
+            int j = i - rand() % (i % 256 + 1);
+            int t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+        }
+        int *from = (int*)malloc(sizeof(int) * m);
+        int *to = (int*)malloc(sizeof(int) * m);
+        for(int i = 0;i < m;i++) {
+            //大多是局部的边，偶尔有长边
+            int a = rand() % (n - 1),len = rand() % 16 == 0 ? rand() % n + 1 : rand() % 64 + 1;
+            int b = a + len < n ? a + len : n - 1;
+            from[i] = perm[a];
+            to[i] = perm[b];
+        }
+        InitDynTopo(&D,n);
+        for(int i = 0;i < n;i++) AddVertex(&D);
+        clock_t begin = clock();
+        int rejected = 0;
+        for(int i = 0;i < m;i++) {
+            if(InsertEdge(&D,from[i],to[i]) == ERROR) rejected++;
+        }
+        printf("Pearce-Kelly V=%d E=%d rejected=%d valid=%s time=%.3fs\n",n,D.numEdges,rejected,
+               CheckOrder(&D) == OK ? "YES" : "NO",(double)(clock() - begin) / CLOCKS_PER_SEC);
+        DestroyDynTopo(&D);
+        if(k == 0) {
+            //每次重排，O(E(V+E))，只在小图上跑
+            int *inDegree = (int*)malloc(sizeof(int) * n);
+            int *queue = (int*)malloc(sizeof(int) * n);
+            InitDynTopo(&D,n);
+            for(int i = 0;i < n;i++) AddVertex(&D);
+            begin = clock();
+            for(int i = 0;i < m;i++) {
+                ListPush(&D.out[from[i]],to[i]);
+                ListPush(&D.in[to[i]],from[i]);
+                D.numEdges++;
+                TopoSortAll(&D,inDegree,queue);
+            }
+            printf("Recompute    V=%d E=%d time=%.3fs\n",n,D.numEdges,(double)(clock() - begin) / CLOCKS_PER_SEC);
+            DestroyDynTopo(&D);
+            free(inDegree);
+            free(queue);
+        }
+        free(perm);
+        free(from);
+        free(to);
+    }
+    return 0;
+}
@@ -0,0 +1,344 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../CSR.h"
+#include "../SCC.h"
+/*
+可达性索引：反复回答"顶点vi到vj之间是否存在路径"
+每次DFS/BFS一遍是O(V+E)，百万次查询太慢，先建索引：
+1 强连通分量缩点：同一SCC内两两可达，只需在缩点后的DAG上回答，SCC编号取拓扑序，
+  cu > cv 时一定不可达(DAG的边只从小编号指向大编号)
+2 2-hop标签(剪枝标号法)：每个点有出标签Lout和入标签Lin(都是"枢纽"点的集合)，
+  u能到v 当且仅当 Lout(u)与Lin(v)有公共枢纽
+  按(入度+1)*(出度+1)从大到小依次取枢纽r，从r正向BFS把r加入所到之处的Lin，反向BFS加入Lout；
+  BFS到w时若已有标签能回答r能否到w，就不再加入也不再扩展(剪枝)，枢纽按序号加入，标签天然有序
+查询 = 两个有序数组求是否相交，一般只有几个到几十个元素
+*/
+typedef struct {
+    int numNodes,numComp;
+    int *comp; // 原图顶点所在的SCC(拓扑序编号)
+    int *outOffset,*outLabel; // 第c个SCC的出标签为 outLabel[outOffset[c]..outOffset[c+1]-1]，存枢纽序号
+    int *inOffset,*inLabel;
+    long long dagEdges;
+} ReachIndex;
+
+//缩点后的DAG(去掉重边和SCC内部的边)，isReverse为1时边反向
+int BuildDAG(const CSRGraph *G,const int *comp,int numComp,int isReverse,CSRGraph *D) {
+    int *from = (int*)malloc(sizeof(int) * (G->numEdges > 0 ? G->numEdges : 1));
+    int *to = (int*)malloc(sizeof(int) * (G->numEdges > 0 ? G->numEdges : 1));
+    int m = 0;
+    if(!from || !to) {
+        free(from);
+        free(to);
+        return 0;
+    }
+    for(int u = 0;u < G->numNodes;u++) {
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            int cu = comp[u],cv = comp[G->adj[e]];
+            if(cu == cv) continue;
+            from[m] = isReverse ? cv : cu;
+            to[m] = isReverse ? cu : cv;
+            m++;
+        }
+    }
+    CSRGraph T;
+    int ok = BuildCSR(&T,numComp,m,from,to,NULL,0);
+    free(from);
+    free(to);
+    if(!ok) return 0;
+    //去重边：last[v]记录v最后一次出现在哪个顶点的出边里
+    int *last = (int*)malloc(sizeof(int) * (numComp > 0 ? numComp : 1));
+    if(!last) {
+        FreeCSR(&T);
+        return 0;
+    }
+    for(int c = 0;c < numComp;c++) last[c] = -1;
+    int k = 0;
+    for(int c = 0;c < numComp;c++) {
+        int begin = T.offset[c];
+        T.offset[c] = k;
+        for(int e = begin;e < T.offset[c + 1];e++) {
+            if(last[T.adj[e]] == c) continue;
+            last[T.adj[e]] = c;
+            T.adj[k++] = T.adj[e];
+        }
+    }
+    T.offset[numComp] = k;
+    T.numEdges = k;
+    free(last);
+    *D = T;
+    return 1;
+}
+
+/* 2-hop标签 *************************************** */
+typedef struct {
+    int *data;
+    int size,capacity;
+} IntList;
+
+int ListPush(IntList *L,int x) {
+    if(L->size == L->capacity) {
+        int capacity = L->capacity ? L->capacity * 2 : 4;
+        int *grown = (int*)realloc(L->data,sizeof(int) * capacity);
+        if(!grown) return 0;
+        L->data = grown;
+        L->capacity = capacity;
+    }
+    L->data[L->size++] = x;
+    return 1;
+}
+
+void FreeLists(IntList *L,int n) {
+    for(int i = 0;i < n;i++) free(L[i].data);
+    free(L);
+}
+//把每个点的标签拼成一个数组，L随之释放
+int Flatten(IntList *L,int n,int **offset,int **label) {
+    long long total = 0;
+    *offset = (int*)malloc(sizeof(int) * (n + 1));
+    for(int i = 0;i < n;i++) total += L[i].size;
+    *label = (int*)malloc(sizeof(int) * (total > 0 ? total : 1));
+    int ok = *offset && *label;
+    total = 0;
+    for(int i = 0;ok && i < n;i++) {
+        (*offset)[i] = (int)total;
+        if(L[i].size) memcpy(*label + total,L[i].data,sizeof(int) * L[i].size);
+        total += L[i].size;
+    }
+    if(ok) (*offset)[n] = (int)total;
+    FreeLists(L,n);
+    return ok;
+}
+//从枢纽r(序号rank)出发BFS，D为正向DAG时填Lin，为反向DAG时填Lout
+//mark[k] == stamp 表示枢纽k在r的另一侧标签里：w的标签中有这样的k就说明已能回答，剪枝。内存不足返回0
+int PrunedBFS(const CSRGraph *D,int r,int rank,IntList *label,const int *mark,int stamp,int *queue,int *visited) {
+    int head = 0,tail = 0;
+    queue[tail++] = r;
+    visited[r] = stamp;
+    while(head < tail) {
+        int w = queue[head++];
+        int covered = 0;
+        for(int i = 0;i < label[w].size && !covered;i++) covered = mark[label[w].data[i]] == stamp;
+        if(covered) continue;
+        if(!ListPush(&label[w],rank)) return 0;
+        for(int e = D->offset[w];e < D->offset[w + 1];e++) {
+            int x = D->adj[e];
+            if(visited[x] != stamp) {
+                visited[x] = stamp;
+                queue[tail++] = x;
+            }
+        }
+    }
+    return 1;
+}
+
+int CompareDesc(const void *a,const void *b) {
+    long long x = *(const long long*)a,y = *(const long long*)b;
+    return x < y ? 1 : (x > y ? -1 : 0);
+}
+
+void FreeReachIndex(ReachIndex *R) {
+    free(R->comp);
+    free(R->outOffset); free(R->outLabel);
+    free(R->inOffset); free(R->inLabel);
+    memset(R,0,sizeof(ReachIndex));
+}
+//失败时已分配的部分都释放，R可直接丢弃
+int BuildReachIndex(ReachIndex *R,const CSRGraph *G) {
+    int n = G->numNodes;
+    memset(R,0,sizeof(ReachIndex));
+    R->numNodes = n;
+    R->comp = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int k = R->comp ? TarjanSCC(G,R->comp) : -1;
+    R->numComp = k;
+    CSRGraph D = {0},B = {0};
+    if(k < 0 || !BuildDAG(G,R->comp,k,0,&D) || !BuildDAG(G,R->comp,k,1,&B)) {
+        FreeCSR(&D);
+        FreeReachIndex(R);
+        return 0;
+    }
+    R->dagEdges = D.numEdges;
+    //枢纽顺序：(入度+1)*(出度+1)大的先处理，分数和编号打包成一个整数降序排序，同分时拓扑序靠前的先
+    long long *key = (long long*)malloc(sizeof(long long) * (k > 0 ? k : 1));
+    int *order = (int*)malloc(sizeof(int) * (k > 0 ? k : 1));
+    IntList *lin = (IntList*)calloc(k > 0 ? k : 1,sizeof(IntList));
+    IntList *lout = (IntList*)calloc(k > 0 ? k : 1,sizeof(IntList));
+    int *mark = (int*)calloc(k > 0 ? k : 1,sizeof(int));
+    int *visited = (int*)calloc(k > 0 ? k : 1,sizeof(int));
+    int *queue = (int*)malloc(sizeof(int) * (k > 0 ? k : 1));
+    int ok = key && order && lin && lout && mark && visited && queue;
+    if(ok) {
+        for(int c = 0;c < k;c++) {
+            long long score = (long long)(OutDegreeCSR(&D,c) + 1) * (OutDegreeCSR(&B,c) + 1);
+            key[c] = (score << 32) | (unsigned)(k - 1 - c);
+        }
+        qsort(key,k,sizeof(long long),CompareDesc);
+        for(int i = 0;i < k;i++) order[i] = k - 1 - (int)(key[i] & 0xffffffffLL);
+    }
+    int stamp = 0;
+    for(int i = 0;ok && i < k;i++) {
+        int r = order[i];
+        //正向：r能到w，w的Lin加入i；已知r能到w当且仅当 Lout(r)与Lin(w)相交
+        stamp++;
+        for(int j = 0;j < lout[r].size;j++) mark[lout[r].data[j]] = stamp;
+        ok = PrunedBFS(&D,r,i,lin,mark,stamp,queue,visited);
+        //反向：w能到r，w的Lout加入i
+        stamp++;
+        for(int j = 0;ok && j < lin[r].size;j++) mark[lin[r].data[j]] = stamp;
+        ok = ok && PrunedBFS(&B,r,i,lout,mark,stamp,queue,visited);
+    }
+    if(ok) {
+        ok = Flatten(lout,k,&R->outOffset,&R->outLabel);
+        ok = Flatten(lin,k,&R->inOffset,&R->inLabel) && ok;
+    } else {
+        if(lin) FreeLists(lin,k);
+        if(lout) FreeLists(lout,k);
+    }
+    free(key); free(mark); free(visited); free(queue); free(order);
+    FreeCSR(&D);
+    FreeCSR(&B);
+    if(!ok) FreeReachIndex(R);
+    return ok;
+}
+
+//u能否到达v
+int Reachable(const ReachIndex *R,int u,int v) {
+    int cu = R->comp[u],cv = R->comp[v];
+    if(cu == cv) return 1;
+    if(cu > cv) return 0;
+    const int *a = R->outLabel + R->outOffset[cu],*aEnd = R->outLabel + R->outOffset[cu + 1];
+    const int *b = R->inLabel + R->inOffset[cv],*bEnd = R->inLabel + R->inOffset[cv + 1];
+    while(a < aEnd && b < bEnd) {
+        if(*a == *b) return 1;
+        if(*a < *b) a++;
+        else b++;
+    }
+    return 0;
+}
+
+long long IndexBytes(const ReachIndex *R) {
+    return sizeof(int) * ((long long)R->numNodes + 2LL * (R->numComp + 1) +
+                          R->outOffset[R->numComp] + R->inOffset[R->numComp]);
+}
+
+/* 演示 ********************************************* */
+//对照：每次BFS
+int ReachableBFS(const CSRGraph *G,int u,int v,int *visited,int stamp,int *queue) {
+    int head = 0,tail = 0;
+    queue[tail++] = u;
+    visited[u] = stamp;
+    while(head < tail) {
+        int w = queue[head++];
+        if(w == v) return 1;
+        for(int e = G->offset[w];e < G->offset[w + 1];e++) {
+            if(visited[G->adj[e]] != stamp) {
+                visited[G->adj[e]] = stamp;
+                queue[tail++] = G->adj[e];
+            }
+        }
+    }
+    return 0;
+}
+
+unsigned Rand32() {
+    return (unsigned)rand() * 32768u + (unsigned)rand();
+}
+
+double Elapsed(clock_t begin) {
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    //小例子：1->2->3->1 成环，3->4，5->4
+    CSRGraph G;
+    ReachIndex R;
+    int from[] = {0,1,2,2,4},to[] = {1,2,0,3,3};
+    if(!BuildCSR(&G,5,5,from,to,NULL,0) || !BuildReachIndex(&R,&G)) return 1;
+    for(int u = 0;u < 5;u++) {
+        for(int v = 0;v < 5;v++) printf("%d ",Reachable(&R,u,v));
+        printf("\n");
+    }
+    FreeReachIndex(&R);
+    FreeCSR(&G);
+
+    //策略图：5层继承关系 部门->角色->组->子组->用户/资源，每层是上一层的10倍，
+    //每个顶点挂1~3个上层顶点，中间层有1%的顶点两两互相继承(形成环)
+    printf("\n*******\n");
+    srand(2024);
+    int n = 1000000,m = 0,size[5],start[6],rest = n;
+    for(int l = 4;l >= 0;l--) {
+        size[l] = l ? rest / 10 * 9 : rest;
+        rest -= size[l];
+    }
+    start[0] = 0;
+    for(int l = 0;l < 5;l++) start[l + 1] = start[l] + size[l];
+    int *f = (int*)malloc(sizeof(int) * n * 4),*t = (int*)malloc(sizeof(int) * n * 4);
+    if(!f || !t) return 1;
+    for(int l = 1;l < 5;l++) {
+        for(int v = start[l];v < start[l + 1];v++) {
+            for(int k = rand() % 3;k >= 0;k--) {
+                f[m] = start[l - 1] + (int)(Rand32() % size[l - 1]);
+                t[m++] = v;
+            }
+        }
+    }
+    for(int l = 1;l < 4;l++) {
+        for(int i = 0;i < size[l] / 100;i++) {
+            int u = start[l] + (int)(Rand32() % size[l]),w = start[l] + (int)(Rand32() % size[l]);
+            f[m] = u; t[m++] = w;
+            f[m] = w; t[m++] = u;
+        }
+    }
+    CSRGraph P; // 反图，用来沿继承关系往上走
+    int built = BuildCSR(&G,n,m,f,t,NULL,0) && BuildCSR(&P,n,m,t,f,NULL,0);
+    free(f);
+    free(t);
+    if(!built) return 1;
+    clock_t begin = clock();
+    if(!BuildReachIndex(&R,&G)) {
+        printf("out of memory\n");
+        return 1;
+    }
+    double build = Elapsed(begin);
+    printf("Graph n=%d m=%d, SCC %d, DAG edges %lld\n",n,m,R.numComp,R.dagEdges);
+    printf("Build time=%.3fs, index %.1f MB, average label %.1f + %.1f\n",build,IndexBytes(&R) / 1048576.0,
+           (double)R.outOffset[R.numComp] / R.numComp,(double)R.inOffset[R.numComp] / R.numComp);
+
+    int q = 1000000,yes = 0;
+    int *qu = (int*)malloc(sizeof(int) * q),*qv = (int*)malloc(sizeof(int) * q);
+    char *ans = (char*)malloc(q);
+    //查询：某个上层顶点能否到达某个用户/资源，一半是从该用户往上随机走几步得到的祖先(一定可达)
+    for(int i = 0;i < q;i++) {
+        qv[i] = start[4] + (int)(Rand32() % size[4]);
+        if(i % 2) {
+            qu[i] = (int)(Rand32() % start[4]);
+            continue;
+        }
+        int u = qv[i];
+        for(int k = 1 + rand() % 4;k > 0 && OutDegreeCSR(&P,u);k--) {
+            u = P.adj[P.offset[u] + rand() % OutDegreeCSR(&P,u)];
+        }
+        qu[i] = u;
+    }
+    begin = clock();
+    for(int i = 0;i < q;i++) {
+        ans[i] = (char)Reachable(&R,qu[i],qv[i]);
+        yes += ans[i];
+    }
+    double qt = Elapsed(begin);
+    printf("%d queries, %d reachable, time=%.3fs, %.0f ns/query\n",q,yes,qt,qt * 1e9 / q);
+
+    //抽查：与BFS对比
+    int *visited = (int*)calloc(n,sizeof(int)),*queue = (int*)malloc(sizeof(int) * n);
+    int check = 200,wrong = 0;
+    begin = clock();
+    for(int i = 0;i < check;i++) wrong += ReachableBFS(&G,qu[i],qv[i],visited,i + 1,queue) != ans[i];
+    qt = Elapsed(begin);
+    printf("BFS check %d queries, wrong %d, %.0f us/query\n",check,wrong,qt * 1e6 / check);
+    free(visited); free(queue); free(qu); free(qv); free(ans);
+    FreeReachIndex(&R);
+    FreeCSR(&G);
+    FreeCSR(&P);
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../GraphLoader.h"
+/*
+用GraphLoader.h从文件加载图
+用法：程序名 [图文件]，文件以%%MatrixMarket开头按Matrix Market读，否则按边表读
+不给文件时生成一个随机边表，比较 fscanf逐条读 / 分块解析 / mmap二进制CSR 三种方式
+*/
+double Now() {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+//与Create()一样用scanf逐条读，作为对照
+int LoadEdgeListScanf(const char *path,CSRGraph *G) {
+    FILE *fp = fopen(path,"r");
+    if(!fp) return 0;
+    int capacity = 1024,count = 0,maxId = -1,u,v,w;
+    int *from = (int*)malloc(sizeof(int) * capacity);
+    int *to = (int*)malloc(sizeof(int) * capacity);
+    int *weight = (int*)malloc(sizeof(int) * capacity);
+    //跳过第一行注释
+    while((u = fgetc(fp)) != EOF && u != '\n');
+    while(fscanf(fp,"%d %d %d",&u,&v,&w) == 3) {
+        if(count == capacity) {
+            capacity *= 2;
+            from = (int*)realloc(from,sizeof(int) * capacity);
+            to = (int*)realloc(to,sizeof(int) * capacity);
+            weight = (int*)realloc(weight,sizeof(int) * capacity);
+        }
+        from[count] = u;
+        to[count] = v;
+        weight[count] = w;
+        if(u > maxId) maxId = u;
+        if(v > maxId) maxId = v;
+        count++;
+    }
+    fclose(fp);
+    int ok = BuildCSR(G,maxId + 1,count,from,to,weight,0);
+    free(from);
+    free(to);
+    free(weight);
+    return ok;
+}
+
+int SameCSR(const CSRGraph *A,const CSRGraph *B) {
+    return A->numNodes == B->numNodes && A->numEdges == B->numEdges &&
+           memcmp(A->offset,B->offset,sizeof(int) * (A->numNodes + 1)) == 0 &&
+           memcmp(A->adj,B->adj,sizeof(int) * A->numEdges) == 0 &&
+           memcmp(A->weight,B->weight,sizeof(int) * A->numEdges) == 0;
+}
+
+void PrintSummary(const CSRGraph *G) {
+    int maxDegree = 0;
+    long long total = 0;
+    for(int v = 0;v < G->numNodes;v++) {
+        int d = OutDegreeCSR(G,v);
+        if(d > maxDegree) maxDegree = d;
+    }
+    for(int e = 0;e < G->numEdges;e++) total += G->weight[e];
+    printf("Nodes %d edges %d max out-degree %d total weight %lld\n",G->numNodes,G->numEdges,maxDegree,total);
+}
+
+int LoadAny(const char *path,CSRGraph *G) {
+    char head[16] = {0};
+    FILE *fp = fopen(path,"r");
+    if(!fp) {
+        printf("Cannot open %s\n",path);
+        return 0;
+    }
+    size_t n = fread(head,1,sizeof(head) - 1,fp);
+    fclose(fp);
+    if(n >= 14 && strncmp(head,"%%MatrixMarket",14) == 0) return LoadMatrixMarket(path,G);
+    return LoadEdgeList(path,G,0,0);
+}
+
+int main(int argc,char *argv[]) {
+    CSRGraph G,H;
+    double begin;
+    if(argc > 1) {
+        begin = Now();
+        if(!LoadAny(argv[1],&G)) return 1;
+        printf("Load %s time=%.3fs\n",argv[1],Now() - begin);
+        PrintSummary(&G);
+        FreeCSR(&G);
+        return 0;
+    }
+
+    //小的Matrix Market例子：对称矩阵只给下三角
+    const char *mtx = "graph_demo.mtx";
+    FILE *fp = fopen(mtx,"w");
+    fprintf(fp,"%%%%MatrixMarket matrix coordinate integer symmetric\n");
+    fprintf(fp,"%% 4个顶点的无向带权图\n4 4 5\n2 1 3\n3 1 5\n3 2 1\n4 3 7\n4 4 2\n");
+    fclose(fp);
+    if(LoadMatrixMarket(mtx,&G)) {
+        for(int v = 0;v < G.numNodes;v++) {
+            printf("%d:",v + 1);
+            for(int e = G.offset[v];e < G.offset[v + 1];e++) printf(" ->%d(%d)",G.adj[e] + 1,G.weight[e]);
+            printf("\n");
+        }
+        FreeCSR(&G);
+    }
+    remove(mtx);
+
+    //随机边表
+    printf("\n*******\n");
+    const char *txt = "graph_demo.txt",*bin = "graph_demo.csr";
+    int n = 1000000,m = 8000000;
+    fp = fopen(txt,"w");
+    fprintf(fp,"# random graph %d nodes %d edges\n",n,m);
+    srand(2024);
+    for(int i = 0;i < m;i++) {
+        int u = (int)(((unsigned)rand() * 32768u + rand()) % n);
+        int v = (int)(((unsigned)rand() * 32768u + rand()) % n);
+        fprintf(fp,"%d %d %d\n",u,v,rand() % 100 + 1);
+    }
+    fclose(fp);
+    printf("Edge list: %d nodes %d edges\n",n,m);
+
+    begin = Now();
+    LoadEdgeListScanf(txt,&H);
+    printf("fscanf         time=%.3fs\n",Now() - begin);
+
+    begin = Now();
+    if(!LoadEdgeList(txt,&G,0,0)) return 1;
+    printf("chunked parse  time=%.3fs %s\n",Now() - begin,SameCSR(&G,&H) ? "OK" : "DIFFERENT");
+    FreeCSR(&H);
+
+    begin = Now();
+    SaveBinaryCSR(bin,&G);
+    printf("save binary    time=%.3fs\n",Now() - begin);
+
+    MappedCSR M;
+    begin = Now();
+    if(!MapBinaryCSR(bin,&M)) return 1;
+    printf("mmap binary    time=%.6fs\n",Now() - begin);
+    //MapBinaryCSR校验时已顺序读过所有页面，这里是读热数据的遍历时间
+    begin = Now();
+    PrintSummary(&M.G);
+    printf("first scan     time=%.3fs %s\n",Now() - begin,SameCSR(&G,&M.G) ? "OK" : "DIFFERENT");
+    UnmapBinaryCSR(&M);
+    FreeCSR(&G);
+    remove(txt);
+    remove(bin);
+    return 0;
+}
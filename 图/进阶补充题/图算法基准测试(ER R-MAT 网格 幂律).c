@@ -0,0 +1,584 @@
+#define _POSIX_C_SOURCE 199309L // clock_gettime、CLOCK_MONOTONIC
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "../CSR.h"
+/*
+图算法基准测试
+图-邻接矩阵.c、图-邻接表.c的main只在几个手工输入的小图上跑，看不出各算法在大图上的表现
+这里生成4种合成图，在同一个CSR上跑DFS、BFS、Dijkstra、Floyd、Prim、Kruskal、TopoSort、EdmondsKarp，
+每个算法一行CSV：
+graph,vertices,edges,algorithm,wall_s,traversed,teps,peak_rss_kb,scratch_kb,counters
+traversed为检查过的边数(Floyd为检查过的矩阵元素数)，teps = traversed / wall_s
+peak_rss_kb为进程到目前为止的最大常驻内存，scratch_kb为该算法自己申请的临时内存峰值
+counters为分号分隔的各阶段计数与分阶段耗时
+生成器：
+1 ER：G(n,m)，均匀随机取m条边
+2 R-MAT：每条边递归地以概率a,b,c,d落入邻接矩阵四个象限，度分布偏斜(Graph500的Kronecker图)
+3 grid：二维网格，直径大，BFS层数多
+4 powerlaw：优先连接(Barabasi-Albert)，新顶点按度的比例连向已有顶点
+用法：图算法基准测试 [scale] [edgefactor]，顶点数 2^scale，边数 顶点数*edgefactor(无向图存两条弧，2*边数不能超过INT_MAX)
+Floyd为O(V^3)，只在前FLOYD_MAX个顶点的导出子图上跑
+*/
+#define INF 0x3fffffff
+#define FLOYD_MAX 512
+#define MAX_COUNTERS 8
+
+/* 计时与内存 ***************************************** */
+double Now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+long PeakRSS() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF,&usage);
+    return usage.ru_maxrss; // Linux下单位为KB
+}
+//算法内部的临时内存都从这里申请，统计当前与峰值字节数
+size_t liveBytes,peakBytes;
+void *BenchAlloc(size_t size) {
+    size_t *p = (size_t*)malloc(sizeof(size_t) + (size ? size : 1));
+    if(!p) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    *p = size;
+    liveBytes += size;
+    if(liveBytes > peakBytes) peakBytes = liveBytes;
+    return p + 1;
+}
+
+void BenchFree(void *ptr) {
+    if(!ptr) return;
+    size_t *p = (size_t*)ptr - 1;
+    liveBytes -= *p;
+    free(p);
+}
+
+/* 统计结果 ******************************************* */
+typedef struct {
+    long long traversed;
+    int numCounters;
+    const char *name[MAX_COUNTERS];
+    double value[MAX_COUNTERS];
+} Stats;
+
+void AddCounter(Stats *S,const char *name,double value) {
+    if(S->numCounters < MAX_COUNTERS) {
+        S->name[S->numCounters] = name;
+        S->value[S->numCounters++] = value;
+    }
+}
+
+/* 合成图 ********************************************* */
+//无向边表，每条边(from[i],to[i],w[i])
+typedef struct {
+    int numNodes,numEdges,capacity;
+    int *from,*to,*w;
+} EdgeList;
+
+unsigned Rand32() {
+    return (unsigned)rand() * 32768u + rand();
+}
+
+void InitEdgeList(EdgeList *L,int numNodes,int capacity) {
+    L->numNodes = numNodes;
+    L->numEdges = 0;
+    L->capacity = capacity > 0 ? capacity : 1;
+    L->from = (int*)malloc(sizeof(int) * L->capacity);
+    L->to = (int*)malloc(sizeof(int) * L->capacity);
+    L->w = (int*)malloc(sizeof(int) * L->capacity);
+}
+
+void FreeEdgeList(EdgeList *L) {
+    free(L->from);
+    free(L->to);
+    free(L->w);
+}
+//去掉自环，权值1~100
+void AddEdge(EdgeList *L,int u,int v) {
+    if(u == v || L->numEdges == L->capacity) return;
+    L->from[L->numEdges] = u;
+    L->to[L->numEdges] = v;
+    L->w[L->numEdges++] = 1 + rand() % 100;
+}
+
+void GenerateER(EdgeList *L,int n,int m) {
+    InitEdgeList(L,n,m);
+    for(int i = 0;i < m;i++) {
+        AddEdge(L,Rand32() % n,Rand32() % n);
+    }
+}
+
+void GenerateRMAT(EdgeList *L,int scale,int m) {
+    int n = 1 << scale;
+    InitEdgeList(L,n,m);
+    //打乱顶点编号，避免度大的点都集中在小编号
+    int *perm = (int*)malloc(sizeof(int) * n);
+    for(int i = 0;i < n;i++) perm[i] = i;
+    for(int i = n - 1;i > 0;i--) {
+        int j = Rand32() % (i + 1),tmp = perm[i];
+        perm[i] = perm[j];
+        perm[j] = tmp;
+    }
+    //a=0.57 b=0.19 c=0.19 d=0.05
+    for(int i = 0;i < m;i++) {
+        int u = 0,v = 0;
+        for(int bit = 0;bit < scale;bit++) {
+            int r = rand() % 100;
+            if(r >= 57 && r < 76) v |= 1 << bit;
+            else if(r >= 76 && r < 95) u |= 1 << bit;
+            else if(r >= 95) {
+                u |= 1 << bit;
+                v |= 1 << bit;
+            }
+        }
+        AddEdge(L,perm[u],perm[v]);
+    }
+    free(perm);
+}
+
+void GenerateGrid(EdgeList *L,int n) {
+    int side = 1;
+    while((side + 1) * (side + 1) <= n) side++;
+    n = side * side;
+    InitEdgeList(L,n,2 * n);
+    for(int i = 0;i < n;i++) {
+        if(i % side + 1 < side) AddEdge(L,i,i + 1);
+        if(i + side < n) AddEdge(L,i,i + side);
+    }
+}
+//每个新顶点连k条边，终点从已有边的端点中均匀抽取，即按度的比例
+void GeneratePowerLaw(EdgeList *L,int n,int k) {
+    InitEdgeList(L,n,n * k);
+    for(int v = 1;v < n;v++) {
+        for(int j = 0;j < k && j < v;j++) {
+            int count = L->numEdges;
+            int u = count > 0 && rand() % 2 ? (rand() % 2 ? L->from : L->to)[(int)(Rand32() % count)] : (int)(Rand32() % v);
+            AddEdge(L,v,u);
+        }
+    }
+}
+
+/* 算法 *********************************************** */
+//非递归DFS遍历全图，it[v]为v下一条待检查的边
+void BenchDFS(const CSRGraph *G,Stats *S) {
+    int n = G->numNodes,maxDepth = 0,components = 0;
+    char *visited = (char*)BenchAlloc(n);
+    int *it = (int*)BenchAlloc(sizeof(int) * n);
+    int *stack = (int*)BenchAlloc(sizeof(int) * n);
+    memset(visited,0,n);
+    for(int s = 0;s < n;s++) {
+        if(visited[s]) continue;
+        components++;
+        int top = 0;
+        stack[top++] = s;
+        visited[s] = 1;
+        it[s] = G->offset[s];
+        while(top) {
+            int u = stack[top - 1];
+            if(it[u] == G->offset[u + 1]) {
+                top--;
+                continue;
+            }
+            int v = G->adj[it[u]++];
+            S->traversed++;
+            if(!visited[v]) {
+                visited[v] = 1;
+                it[v] = G->offset[v];
+                stack[top++] = v;
+                if(top > maxDepth) maxDepth = top;
+            }
+        }
+    }
+    AddCounter(S,"components",components);
+    AddCounter(S,"max_depth",maxDepth);
+    BenchFree(visited); BenchFree(it); BenchFree(stack);
+}
+//从s出发的BFS，逐层统计
+void BenchBFS(const CSRGraph *G,int s,Stats *S) {
+    int n = G->numNodes;
+    int *level = (int*)BenchAlloc(sizeof(int) * n);
+    int *queue = (int*)BenchAlloc(sizeof(int) * n);
+    for(int v = 0;v < n;v++) level[v] = -1;
+    int head = 0,tail = 0,levels = 0,maxFrontier = 0;
+    level[s] = 0;
+    queue[tail++] = s;
+    while(head < tail) {
+        int end = tail;
+        if(end - head > maxFrontier) maxFrontier = end - head;
+        levels++;
+        for(;head < end;head++) {
+            int u = queue[head];
+            for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+                int v = G->adj[e];
+                S->traversed++;
+                if(level[v] < 0) {
+                    level[v] = level[u] + 1;
+                    queue[tail++] = v;
+                }
+            }
+        }
+    }
+    AddCounter(S,"reached",tail);
+    AddCounter(S,"levels",levels);
+    AddCounter(S,"max_frontier",maxFrontier);
+    BenchFree(level); BenchFree(queue);
+}
+//懒删除二叉堆
+typedef struct {
+    int key,vex;
+} HeapNode;
+
+void HeapPush(HeapNode *H,int *size,int key,int vex) {
+    int i = (*size)++;
+    while(i > 0 && H[(i - 1) / 2].key > key) {
+        H[i] = H[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    H[i].key = key;
+    H[i].vex = vex;
+}
+
+HeapNode HeapPop(HeapNode *H,int *size) {
+    HeapNode top = H[0],last = H[--(*size)];
+    int i = 0;
+    while(2 * i + 1 < *size) {
+        int c = 2 * i + 1;
+        if(c + 1 < *size && H[c + 1].key < H[c].key) c++;
+        if(H[c].key >= last.key) break;
+        H[i] = H[c];
+        i = c;
+    }
+    if(*size > 0) H[i] = last;
+    return top;
+}
+
+void BenchDijkstra(const CSRGraph *G,int s,Stats *S) {
+    int n = G->numNodes,size = 0;
+    long long pushes = 0,stale = 0;
+    int *dist = (int*)BenchAlloc(sizeof(int) * n);
+    HeapNode *heap = (HeapNode*)BenchAlloc(sizeof(HeapNode) * (G->numEdges + 1));
+    for(int v = 0;v < n;v++) dist[v] = INF;
+    dist[s] = 0;
+    HeapPush(heap,&size,0,s);
+    pushes++;
+    while(size) {
+        HeapNode top = HeapPop(heap,&size);
+        int u = top.vex;
+        if(top.key > dist[u]) {
+            stale++;
+            continue;
+        }
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            int v = G->adj[e];
+            S->traversed++;
+            if(dist[u] + G->weight[e] < dist[v]) {
+                dist[v] = dist[u] + G->weight[e];
+                HeapPush(heap,&size,dist[v],v);
+                pushes++;
+            }
+        }
+    }
+    AddCounter(S,"heap_pushes",pushes);
+    AddCounter(S,"stale_pops",stale);
+    BenchFree(dist); BenchFree(heap);
+}
+//前FLOYD_MAX个顶点的导出子图上的Floyd
+void BenchFloyd(const CSRGraph *G,Stats *S) {
+    int n = G->numNodes < FLOYD_MAX ? G->numNodes : FLOYD_MAX;
+    long long updates = 0;
+    double begin = Now();
+    int *D = (int*)BenchAlloc(sizeof(int) * n * n);
+    for(int i = 0;i < n * n;i++) D[i] = INF;
+    for(int u = 0;u < n;u++) {
+        D[u * n + u] = 0;
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            int v = G->adj[e];
+            if(v < n && G->weight[e] < D[u * n + v]) D[u * n + v] = G->weight[e];
+        }
+    }
+    double init = Now() - begin;
+    begin = Now();
+    for(int k = 0;k < n;k++) {
+        const int *Dk = D + k * n;
+        for(int i = 0;i < n;i++) {
+            int dik = D[i * n + k];
+            if(dik >= INF) continue;
+            int *Di = D + i * n;
+            for(int j = 0;j < n;j++) {
+                if(dik + Dk[j] < Di[j]) {
+                    Di[j] = dik + Dk[j];
+                    updates++;
+                }
+            }
+            S->traversed += n;
+        }
+    }
+    AddCounter(S,"sub_vertices",n);
+    AddCounter(S,"updates",updates);
+    AddCounter(S,"init_s",init);
+    AddCounter(S,"relax_s",Now() - begin);
+    BenchFree(D);
+}
+//懒删除堆的Prim，不连通时得到最小生成森林
+void BenchPrim(const CSRGraph *G,Stats *S) {
+    int n = G->numNodes,size = 0;
+    long long total = 0,pushes = 0;
+    char *inTree = (char*)BenchAlloc(n);
+    HeapNode *heap = (HeapNode*)BenchAlloc(sizeof(HeapNode) * (G->numEdges + 1));
+    memset(inTree,0,n);
+    for(int s = 0;s < n;s++) {
+        if(inTree[s]) continue;
+        HeapPush(heap,&size,0,s);
+        while(size) {
+            HeapNode top = HeapPop(heap,&size);
+            int u = top.vex;
+            if(inTree[u]) continue;
+            inTree[u] = 1;
+            total += top.key;
+            for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+                S->traversed++;
+                if(!inTree[G->adj[e]]) {
+                    HeapPush(heap,&size,G->weight[e],G->adj[e]);
+                    pushes++;
+                }
+            }
+        }
+    }
+    AddCounter(S,"weight",total);
+    AddCounter(S,"heap_pushes",pushes);
+    BenchFree(inTree); BenchFree(heap);
+}
+
+const int *sortWeight;
+int CompareWeight(const void *a,const void *b) {
+    return sortWeight[*(const int*)a] - sortWeight[*(const int*)b];
+}
+
+int FindRoot(int *parent,int x,long long *steps) {
+    while(parent[x] != x) {
+        parent[x] = parent[parent[x]]; // 路径减半
+        x = parent[x];
+        (*steps)++;
+    }
+    return x;
+}
+//Kruskal在原始边表上做：排序 + 按秩并查集，两个阶段分别计时
+void BenchKruskal(const EdgeList *L,Stats *S) {
+    int n = L->numNodes,m = L->numEdges,unions = 0;
+    long long total = 0,steps = 0;
+    double begin = Now();
+    int *order = (int*)BenchAlloc(sizeof(int) * m);
+    for(int i = 0;i < m;i++) order[i] = i;
+    sortWeight = L->w;
+    qsort(order,m,sizeof(int),CompareWeight);
+    double sortTime = Now() - begin;
+    begin = Now();
+    int *parent = (int*)BenchAlloc(sizeof(int) * n);
+    int *size = (int*)BenchAlloc(sizeof(int) * n);
+    for(int v = 0;v < n;v++) {
+        parent[v] = v;
+        size[v] = 1;
+    }
+    for(int i = 0;i < m && unions < n - 1;i++) {
+        int e = order[i];
+        int a = FindRoot(parent,L->from[e],&steps),b = FindRoot(parent,L->to[e],&steps);
+        S->traversed++;
+        if(a == b) continue;
+        if(size[a] < size[b]) {
+            int tmp = a;
+            a = b;
+            b = tmp;
+        }
+        parent[b] = a;
+        size[a] += size[b];
+        total += L->w[e];
+        unions++;
+    }
+    AddCounter(S,"weight",total);
+    AddCounter(S,"unions",unions);
+    AddCounter(S,"find_steps",steps);
+    AddCounter(S,"sort_s",sortTime);
+    AddCounter(S,"union_s",Now() - begin);
+    BenchFree(order); BenchFree(parent); BenchFree(size);
+}
+//Kahn拓扑排序，D为把每条边定向为小编号->大编号得到的DAG
+void BenchTopoSort(const CSRGraph *D,Stats *S) {
+    int n = D->numNodes,head = 0,tail = 0,maxQueue = 0;
+    int *indegree = (int*)BenchAlloc(sizeof(int) * n);
+    int *queue = (int*)BenchAlloc(sizeof(int) * n);
+    memset(indegree,0,sizeof(int) * n);
+    for(int e = 0;e < D->numEdges;e++) indegree[D->adj[e]]++;
+    for(int v = 0;v < n;v++) {
+        if(indegree[v] == 0) queue[tail++] = v;
+    }
+    while(head < tail) {
+        if(tail - head > maxQueue) maxQueue = tail - head;
+        int u = queue[head++];
+        for(int e = D->offset[u];e < D->offset[u + 1];e++) {
+            S->traversed++;
+            if(--indegree[D->adj[e]] == 0) queue[tail++] = D->adj[e];
+        }
+    }
+    AddCounter(S,"sorted",tail);
+    AddCounter(S,"max_queue",maxQueue);
+    BenchFree(indegree); BenchFree(queue);
+}
+//EdmondsKarp：无向边容量为权值，同一条边的两条弧互为反向弧
+//BuildCSR放边的顺序是确定的，按同样顺序重放一遍即可得到反向弧下标
+void BenchEdmondsKarp(const CSRGraph *G,const EdgeList *L,int s,int t,Stats *S) {
+    int n = G->numNodes,m = G->numEdges,paths = 0;
+    long long flow = 0;
+    double begin = Now();
+    int *rev = (int*)BenchAlloc(sizeof(int) * m);
+    int *cap = (int*)BenchAlloc(sizeof(int) * m);
+    int *pos = (int*)BenchAlloc(sizeof(int) * n);
+    int *pre = (int*)BenchAlloc(sizeof(int) * n); // 到达顶点的弧
+    int *queue = (int*)BenchAlloc(sizeof(int) * n);
+    memcpy(pos,G->offset,sizeof(int) * n);
+    for(int i = 0;i < L->numEdges;i++) {
+        int a = pos[L->from[i]]++,b = pos[L->to[i]]++;
+        rev[a] = b;
+        rev[b] = a;
+    }
+    memcpy(cap,G->weight,sizeof(int) * m);
+    double build = Now() - begin;
+    begin = Now();
+    while(s != t) {
+        for(int v = 0;v < n;v++) pre[v] = -1;
+        int head = 0,tail = 0;
+        queue[tail++] = s;
+        pre[s] = m; // 源点标记为已访问
+        while(head < tail && pre[t] < 0) {
+            int u = queue[head++];
+            for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+                int v = G->adj[e];
+                S->traversed++;
+                if(cap[e] > 0 && pre[v] < 0) {
+                    pre[v] = e;
+                    queue[tail++] = v;
+                }
+            }
+        }
+        if(pre[t] < 0) break;
+        //沿pre找瓶颈再增广
+        int bottleneck = INF;
+        for(int v = t;v != s;v = G->adj[rev[pre[v]]]) {
+            if(cap[pre[v]] < bottleneck) bottleneck = cap[pre[v]];
+        }
+        for(int v = t;v != s;v = G->adj[rev[pre[v]]]) {
+            cap[pre[v]] -= bottleneck;
+            cap[rev[pre[v]]] += bottleneck;
+        }
+        flow += bottleneck;
+        paths++;
+    }
+    AddCounter(S,"flow",flow);
+    AddCounter(S,"augmenting_paths",paths);
+    AddCounter(S,"build_s",build);
+    AddCounter(S,"augment_s",Now() - begin);
+    BenchFree(rev); BenchFree(cap); BenchFree(pos); BenchFree(pre); BenchFree(queue);
+}
+
+/* 驱动 *********************************************** */
+void PrintRow(const char *graph,const CSRGraph *G,const char *algorithm,double time,const Stats *S) {
+    printf("%s,%d,%d,%s,%.6f,%lld,%.0f,%ld,%.0f,",graph,G->numNodes,G->numEdges / 2,algorithm,time,S->traversed,
+           time > 0 ? S->traversed / time : 0,PeakRSS(),peakBytes / 1024.0);
+    for(int i = 0;i < S->numCounters;i++) {
+        printf(i ? ";%s=%.6g" : "%s=%.6g",S->name[i],S->value[i]);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+//度最大的顶点作为BFS、Dijkstra、最大流的源点，汇点取度第二大的顶点
+void PickEnds(const CSRGraph *G,int *s,int *t) {
+    *s = 0;
+    *t = G->numNodes > 1 ? 1 : 0;
+    for(int v = 0;v < G->numNodes;v++) {
+        if(OutDegreeCSR(G,v) > OutDegreeCSR(G,*s)) {
+            *t = *s;
+            *s = v;
+        } else if(v != *s && OutDegreeCSR(G,v) > OutDegreeCSR(G,*t)) {
+            *t = v;
+        }
+    }
+}
+
+void RunAll(const char *graph,const EdgeList *L) {
+    CSRGraph G,D;
+    if(!BuildCSR(&G,L->numNodes,L->numEdges,L->from,L->to,L->w,1)) {
+        fprintf(stderr,"%s: out of memory\n",graph);
+        return;
+    }
+    //小编号->大编号定向得到DAG
+    int *from = (int*)malloc(sizeof(int) * (L->numEdges > 0 ? L->numEdges : 1));
+    int *to = (int*)malloc(sizeof(int) * (L->numEdges > 0 ? L->numEdges : 1));
+    int ok = from && to;
+    for(int i = 0;ok && i < L->numEdges;i++) {
+        from[i] = L->from[i] < L->to[i] ? L->from[i] : L->to[i];
+        to[i] = L->from[i] < L->to[i] ? L->to[i] : L->from[i];
+    }
+    ok = ok && BuildCSR(&D,L->numNodes,L->numEdges,from,to,L->w,0);
+    free(from);
+    free(to);
+    if(!ok) {
+        fprintf(stderr,"%s: out of memory\n",graph);
+        FreeCSR(&G);
+        return;
+    }
+    int s,t;
+    PickEnds(&G,&s,&t);
+    const char *name[] = {"DFS","BFS","Dijkstra","Floyd","Prim","Kruskal","TopoSort","EdmondsKarp"};
+    for(int a = 0;a < 8;a++) {
+        Stats S;
+        memset(&S,0,sizeof(Stats));
+        peakBytes = liveBytes = 0;
+        double begin = Now();
+        switch(a) {
+            case 0: BenchDFS(&G,&S); break;
+            case 1: BenchBFS(&G,s,&S); break;
+            case 2: BenchDijkstra(&G,s,&S); break;
+            case 3: BenchFloyd(&G,&S); break;
+            case 4: BenchPrim(&G,&S); break;
+            case 5: BenchKruskal(L,&S); break;
+            case 6: BenchTopoSort(&D,&S); break;
+            case 7: BenchEdmondsKarp(&G,L,s,t,&S); break;
+        }
+        PrintRow(graph,&G,name[a],Now() - begin,&S);
+    }
+    FreeCSR(&G);
+    FreeCSR(&D);
+}
+
+int main(int argc,char *argv[]) {
+    int scale = argc > 1 ? atoi(argv[1]) : 14;
+    int edgeFactor = argc > 2 ? atoi(argv[2]) : 8;
+    //无向图每条边存两条弧，弧数2*n*edgefactor要放得进int
+    if(scale < 1 || scale > 26 || edgeFactor < 1 || 2LL * (1 << scale) * edgeFactor > INT_MAX) {
+        printf("Usage: %s [scale 1~26] [edgefactor], 2^(scale+1)*edgefactor <= INT_MAX\n",argv[0]);
+        return 1;
+    }
+    int n = 1 << scale,m = n * edgeFactor;
+    srand(2024);
+    printf("graph,vertices,edges,algorithm,wall_s,traversed,teps,peak_rss_kb,scratch_kb,counters\n");
+    EdgeList L;
+    GenerateER(&L,n,m);
+    RunAll("ER",&L);
+    FreeEdgeList(&L);
+    GenerateRMAT(&L,scale,m);
+    RunAll("RMAT",&L);
+    FreeEdgeList(&L);
+    GenerateGrid(&L,n);
+    RunAll("grid",&L);
+    FreeEdgeList(&L);
+    GeneratePowerLaw(&L,n,edgeFactor);
+    RunAll("powerlaw",&L);
+    FreeEdgeList(&L);
+    return 0;
+}
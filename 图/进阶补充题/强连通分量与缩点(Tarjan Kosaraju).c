@@ -0,0 +1,358 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../CSR.h"
+#include "../SCC.h"
+/*
+有向图的强连通分量(SCC)与缩点
+图/中只有无向图的连通性(isConnected、ConectedCount)，有环的有向依赖图无法直接拓扑排序
+1 Tarjan(放在SCC.h，可达性索引也用)：一次DFS，dfn/low与无向图关节点类似，low[u]==dfn[u]时栈中u以上的点为一个SCC
+  Tarjan得到的SCC编号恰好是逆拓扑序，反过来编号即为缩点图的拓扑序
+2 Kosaraju：先在原图上DFS记录后序，再在反图上按后序倒序DFS，每棵DFS树为一个SCC
+两者都用显式栈，O(V+E)
+3 缩点：每个SCC缩成一个点，SCC之间的边去重(权值取最大，便于关键路径)，得到有向无环图(DAG)
+  缩点图可转回GraphAd(带入度inDegree)，直接交给图-邻接表.c中的TopoSort、CriticalPath
+*/
+#define MAX 100
+
+typedef int PointType;
+
+typedef struct EdgeNode {
+    struct EdgeNode *next;
+    int weight;
+    int adjvex;
+} EdgeNode;
+
+typedef struct PointNode {
+    int inDegree;//入度，用于拓扑排序
+    struct EdgeNode *firstEdge;
+    PointType data;
+} PointNode,AdjList[MAX];
+
+typedef struct {
+    AdjList adjList;
+    int numEdges,numNodes;
+} GraphAd;
+
+void InitGraphAd(GraphAd *G,int numNodes) {
+    G->numNodes = numNodes;
+    G->numEdges = 0;
+    for(int i = 0;i < numNodes;i++) {
+        G->adjList[i].data = i+1;
+        G->adjList[i].firstEdge = NULL;
+        G->adjList[i].inDegree = 0;
+    }
+}
+//添加有向边 ii -> jj(0开始的下标)
+int AddEdgeAd(GraphAd *G,int ii,int jj,int weight) {
+    EdgeNode *E = (EdgeNode *)malloc(sizeof(EdgeNode));
+    if (E == NULL) return 0;
+    E->weight = weight;
+    E->adjvex = jj;
+    E->next = G->adjList[ii].firstEdge;
+    G->adjList[ii].firstEdge = E;
+    G->adjList[jj].inDegree++;
+    G->numEdges++;
+    return 1;
+}
+
+void DestroyGraphAd(GraphAd *G) {
+    for(int i = 0;i < G->numNodes;i++) {
+        EdgeNode *E = G->adjList[i].firstEdge;
+        while(E) {
+            EdgeNode *next = E->next;
+            free(E);
+            E = next;
+        }
+        G->adjList[i].firstEdge = NULL;
+    }
+    G->numEdges = 0;
+}
+//邻接表转CSR
+int AdToCSR(GraphAd *G,CSRGraph *C) {
+    int m = 0;
+    for(int i = 0;i < G->numNodes;i++) {
+        for(EdgeNode *E = G->adjList[i].firstEdge;E;E = E->next) m++;
+    }
+    int *from = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    int *to = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    int *w = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    if(!from || !to || !w) {
+        free(from); free(to); free(w);
+        return 0;
+    }
+    int k = 0;
+    for(int i = 0;i < G->numNodes;i++) {
+        for(EdgeNode *E = G->adjList[i].firstEdge;E;E = E->next) {
+            from[k] = i;
+            to[k] = E->adjvex;
+            w[k] = E->weight;
+            k++;
+        }
+    }
+    int ok = BuildCSR(C,G->numNodes,m,from,to,w,0);
+    free(from);
+    free(to);
+    free(w);
+    return ok;
+}
+
+/* Kosaraju**************************************** */
+//反图：每条边u->v变为v->u
+int TransposeCSR(const CSRGraph *G,CSRGraph *R) {
+    int m = G->numEdges;
+    int *from = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    int *to = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    if(!from || !to) {
+        free(from); free(to);
+        return 0;
+    }
+    for(int u = 0;u < G->numNodes;u++) {
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            from[e] = G->adj[e];
+            to[e] = u;
+        }
+    }
+    int ok = BuildCSR(R,G->numNodes,m,from,to,G->weight,0);
+    free(from);
+    free(to);
+    return ok;
+}
+
+//同TarjanSCC，内存不足返回-1
+int KosarajuSCC(const CSRGraph *G,int *comp) {
+    int n = G->numNodes;
+    int size = n > 0 ? n : 1;
+    int *order = (int*)malloc(sizeof(int) * size); // 后序
+    int *it = (int*)malloc(sizeof(int) * size);
+    int *stack = (int*)malloc(sizeof(int) * size);
+    char *visited = (char*)calloc(size,1);
+    int cnt = 0;
+    CSRGraph R;
+    if(!order || !it || !stack || !visited) {
+        free(order); free(it); free(stack); free(visited);
+        return -1;
+    }
+    //第一遍：原图后序
+    for(int root = 0;root < n;root++) {
+        if(visited[root]) continue;
+        int top = 0;
+        visited[root] = 1;
+        it[root] = G->offset[root];
+        stack[top++] = root;
+        while(top > 0) {
+            int u = stack[top - 1];
+            if(it[u] < G->offset[u + 1]) {
+                int v = G->adj[it[u]++];
+                if(!visited[v]) {
+                    visited[v] = 1;
+                    it[v] = G->offset[v];
+                    stack[top++] = v;
+                }
+            } else {
+                order[cnt++] = u;
+                top--;
+            }
+        }
+    }
+    //第二遍：反图上按后序倒序，每次DFS到的点为一个SCC，且编号即为拓扑序
+    if(!TransposeCSR(G,&R)) {
+        free(order); free(it); free(stack); free(visited);
+        return -1;
+    }
+    for(int i = 0;i < n;i++) comp[i] = -1;
+    int count = 0;
+    for(int i = n - 1;i >= 0;i--) {
+        int root = order[i];
+        if(comp[root] != -1) continue;
+        int top = 0;
+        comp[root] = count;
+        stack[top++] = root;
+        while(top > 0) {
+            int u = stack[--top];
+            for(int e = R.offset[u];e < R.offset[u + 1];e++) {
+                int v = R.adj[e];
+                if(comp[v] == -1) {
+                    comp[v] = count;
+                    stack[top++] = v;
+                }
+            }
+        }
+        count++;
+    }
+    FreeCSR(&R);
+    free(order); free(it); free(stack); free(visited);
+    return count;
+}
+
+/* 缩点******************************************** */
+//SCC之间的边去重，重边权值取最大，得到DAG
+int Condense(const CSRGraph *G,const int *comp,int count,CSRGraph *D) {
+    int m = G->numEdges;
+    int *from = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    int *to = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    int *w = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    if(!from || !to || !w) {
+        free(from); free(to); free(w);
+        return 0;
+    }
+    int k = 0;
+    for(int u = 0;u < G->numNodes;u++) {
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            if(comp[u] != comp[G->adj[e]]) {
+                from[k] = comp[u];
+                to[k] = comp[G->adj[e]];
+                w[k] = G->weight[e];
+                k++;
+            }
+        }
+    }
+    CSRGraph T;
+    int ok = BuildCSR(&T,count,k,from,to,w,0);
+    if(!ok) {
+        free(from); free(to); free(w);
+        return 0;
+    }
+    //去重：last[v]记录上一次出现v的起点，pos[v]为其位置
+    int *last = (int*)malloc(sizeof(int) * (count > 0 ? count : 1));
+    int *pos = (int*)malloc(sizeof(int) * (count > 0 ? count : 1));
+    if(!last || !pos) {
+        free(from); free(to); free(w); free(last); free(pos);
+        FreeCSR(&T);
+        return 0;
+    }
+    for(int i = 0;i < count;i++) last[i] = -1;
+    k = 0;
+    for(int u = 0;u < count;u++) {
+        for(int e = T.offset[u];e < T.offset[u + 1];e++) {
+            int v = T.adj[e];
+            if(last[v] == u) {
+                if(T.weight[e] > w[pos[v]]) w[pos[v]] = T.weight[e];
+            } else {
+                last[v] = u;
+                pos[v] = k;
+                from[k] = u;
+                to[k] = v;
+                w[k] = T.weight[e];
+                k++;
+            }
+        }
+    }
+    FreeCSR(&T);
+    ok = BuildCSR(D,count,k,from,to,w,0);
+    free(from); free(to); free(w); free(last); free(pos);
+    return ok;
+}
+//缩点图转为GraphAd，入度一并求出，点数不能超过MAX
+int CondenseToGraphAd(const CSRGraph *D,GraphAd *G) {
+    if(D->numNodes > MAX) return 0;
+    InitGraphAd(G,D->numNodes);
+    for(int u = 0;u < D->numNodes;u++) {
+        //倒序插入，使链表顺序与CSR一致
+        for(int e = D->offset[u + 1] - 1;e >= D->offset[u];e--) {
+            if(!AddEdgeAd(G,u,D->adj[e],D->weight[e])) return 0;
+        }
+    }
+    return 1;
+}
+//缩点图上的拓扑排序(Kahn)，order存拓扑序列，返回输出的点数，内存不足返回-1
+int TopoSortCSR(const CSRGraph *D,int *order) {
+    int n = D->numNodes;
+    int *inDegree = (int*)calloc(n > 0 ? n : 1,sizeof(int));
+    if(!inDegree) return -1;
+    for(int e = 0;e < D->numEdges;e++) inDegree[D->adj[e]]++;
+    int front = 0,rear = 0;
+    for(int i = 0;i < n;i++) {
+        if(inDegree[i] == 0) order[rear++] = i;
+    }
+    while(front < rear) {
+        int u = order[front++];
+        for(int e = D->offset[u];e < D->offset[u + 1];e++) {
+            if(--inDegree[D->adj[e]] == 0) order[rear++] = D->adj[e];
+        }
+    }
+    free(inDegree);
+    return rear;
+}
+
+int main() {
+    /*示例图
+    1 -> 2 -> 3 -> 1   (SCC {1,2,3})
+    3 -> 4 -> 5 -> 4   (SCC {4,5})
+    5 -> 6, 2 -> 6     (SCC {6})
+    */
+    GraphAd G;
+    InitGraphAd(&G,6);
+    AddEdgeAd(&G,0,1,3);
+    AddEdgeAd(&G,1,2,2);
+    AddEdgeAd(&G,2,0,1);
+    AddEdgeAd(&G,2,3,4);
+    AddEdgeAd(&G,3,4,5);
+    AddEdgeAd(&G,4,3,2);
+    AddEdgeAd(&G,4,5,6);
+    AddEdgeAd(&G,1,5,7);
+    CSRGraph C,D;
+    if(!AdToCSR(&G,&C)) return 1;
+    int comp[6];
+    int count = TarjanSCC(&C,comp);
+    if(count < 0) return 1;
+    printf("Tarjan SCC count %d\n",count);
+    for(int i = 0;i < 6;i++) printf("%d->SCC%d ",G.adjList[i].data,comp[i]+1);
+    count = KosarajuSCC(&C,comp);
+    if(count < 0) return 1;
+    printf("\nKosaraju SCC count %d\n",count);
+    for(int i = 0;i < 6;i++) printf("%d->SCC%d ",G.adjList[i].data,comp[i]+1);
+    if(!Condense(&C,comp,count,&D)) return 1;
+    printf("\nCondensation:");
+    for(int u = 0;u < D.numNodes;u++) {
+        for(int e = D.offset[u];e < D.offset[u + 1];e++) {
+            printf(" <%d-%d>:%d",u+1,D.adj[e]+1,D.weight[e]);
+        }
+    }
+    GraphAd DG;
+    if(!CondenseToGraphAd(&D,&DG)) return 1;
+    printf("\nGraphAd inDegree:");
+    for(int i = 0;i < DG.numNodes;i++) printf(" %d",DG.adjList[i].inDegree);
+    printf("\n");
+    DestroyGraphAd(&DG);
+    DestroyGraphAd(&G);
+    FreeCSR(&C);
+    FreeCSR(&D);
+
+    //随机大图
+    printf("\n*******\n");
+    int n = 1000000,m = 3000000;
+    int *f = (int*)malloc(sizeof(int) * m);
+    int *t = (int*)malloc(sizeof(int) * m);
+    if(!f || !t) return 1;
+    srand(2024);
+    for(int i = 0;i < m;i++) {
+        f[i] = rand() % n;
+        t[i] = rand() % n;
+    }
+    int built = BuildCSR(&C,n,m,f,t,NULL,0);
+    free(f);
+    free(t);
+    if(!built) return 1;
+    int *comp1 = (int*)malloc(sizeof(int) * n);
+    int *comp2 = (int*)malloc(sizeof(int) * n);
+    if(!comp1 || !comp2) return 1;
+    clock_t begin = clock();
+    int c1 = TarjanSCC(&C,comp1);
+    printf("Tarjan   V=%d E=%d SCC=%d time=%.3fs\n",n,m,c1,(double)(clock() - begin) / CLOCKS_PER_SEC);
+    begin = clock();
+    int c2 = KosarajuSCC(&C,comp2);
+    printf("Kosaraju V=%d E=%d SCC=%d time=%.3fs\n",n,m,c2,(double)(clock() - begin) / CLOCKS_PER_SEC);
+    if(c1 < 0 || c2 < 0) return 1;
+    begin = clock();
+    if(!Condense(&C,comp1,c1,&D)) return 1;
+    int *order = (int*)malloc(sizeof(int) * (c1 > 0 ? c1 : 1));
+    int sorted = order ? TopoSortCSR(&D,order) : -1;
+    printf("Condense DAG V=%d E=%d topo=%s time=%.3fs\n",D.numNodes,D.numEdges,sorted == c1 ? "OK" : "ERROR",(double)(clock() - begin) / CLOCKS_PER_SEC);
+    free(order);
+    free(comp1);
+    free(comp2);
+    FreeCSR(&C);
+    FreeCSR(&D);
+    return 0;
+}
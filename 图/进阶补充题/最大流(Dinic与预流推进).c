@@ -0,0 +1,421 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+/*
+最大流：Dinic算法 与 最高标号预流推进(HLPP)
+电能输送(Edmond-Karp算法).c每次BFS只找一条增广路，O(VE^2)，边用malloc的链表存
+这里所有边存在连续数组中(CSR分组)，每条边与其反向边成对，rev[e]为e的反向边下标
+1 Dinic：BFS建分层图level[]，再在分层图上用当前弧it[]做阻塞流，O(V^2 E)，单位容量图O(E sqrt(V))
+2 HLPP：每次推进最高标号的活跃点，配合间隙(gap)优化，O(V^2 sqrt(E))
+3 最小割：最大流后从源点沿残量>0的边BFS，能到达的点为S集，S到T的原边即为最小割
+为了对比，同样的存储上也实现了EdmondsKarp
+*/
+typedef struct {
+    int numNodes,numEdges; // numEdges为弧数，每条输入边对应正反两条弧
+    int *offset; // numNodes+1，顶点i的弧为offset[i]~offset[i+1]-1
+    int *to;
+    int *cap; // 残量
+    int *orig; // 原容量(反向弧为0)，用于重置
+    int *rev; // 反向弧下标
+    int *id; // 正向弧对应的输入边编号，反向弧为-1
+} FlowGraph;
+
+void FreeFlowGraph(FlowGraph *G) {
+    free(G->offset);
+    free(G->to);
+    free(G->cap);
+    free(G->orig);
+    free(G->rev);
+    free(G->id);
+    G->numNodes = G->numEdges = 0;
+}
+//由边数组构造，计数排序放边 O(V+E)
+int BuildFlowGraph(FlowGraph *G,int numNodes,int numEdges,const int *from,const int *to,const int *cap) {
+    int m = numEdges * 2;
+    G->numNodes = numNodes;
+    G->numEdges = m;
+    G->offset = (int*)calloc(numNodes + 1,sizeof(int));
+    G->to = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    G->cap = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    G->orig = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    G->rev = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    G->id = (int*)malloc(sizeof(int) * (m > 0 ? m : 1));
+    int *pos = (int*)malloc(sizeof(int) * (numNodes > 0 ? numNodes : 1));
+    if(!G->offset || !G->to || !G->cap || !G->orig || !G->rev || !G->id || !pos) {
+        free(pos);
+        FreeFlowGraph(G);
+        return 0;
+    }
+    for(int i = 0;i < numEdges;i++) {
+        if(from[i] < 0 || from[i] >= numNodes || to[i] < 0 || to[i] >= numNodes) {
+            printf("Invalid edge (%d, %d)\n",from[i]+1,to[i]+1);
+            free(pos);
+            FreeFlowGraph(G);
+            return 0;
+        }
+        G->offset[from[i] + 1]++;
+        G->offset[to[i] + 1]++;
+    }
+    for(int i = 0;i < numNodes;i++) {
+        G->offset[i + 1] += G->offset[i];
+        pos[i] = G->offset[i];
+    }
+    for(int i = 0;i < numEdges;i++) {
+        int e = pos[from[i]]++;
+        int b = pos[to[i]]++;
+        // 正常边
+        G->to[e] = to[i];
+        G->orig[e] = cap[i];
+        G->id[e] = i;
+        G->rev[e] = b;
+        // 反向边
+        G->to[b] = from[i];
+        G->orig[b] = 0;
+        G->id[b] = -1;
+        G->rev[b] = e;
+    }
+    for(int e = 0;e < m;e++) {
+        G->cap[e] = G->orig[e];
+    }
+    free(pos);
+    return 1;
+}
+//清空流量，恢复原容量
+void ResetFlow(FlowGraph *G) {
+    for(int e = 0;e < G->numEdges;e++) {
+        G->cap[e] = G->orig[e];
+    }
+}
+
+int Min(int a,int b) {
+    return a < b ? a : b;
+}
+
+/* EdmondsKarp(对比用)***************************** */
+//三种算法都是：源汇相同时流量为0，内存不足返回-1
+long long EdmondsKarp(FlowGraph *G,int start,int end) {
+    if(start == end) return 0;
+    int n = G->numNodes;
+    long long maxFlow = 0;
+    int *parent = (int*)malloc(sizeof(int) * n); // 到达该点的弧
+    int *queue = (int*)malloc(sizeof(int) * n);
+    if(!parent || !queue) maxFlow = -1;
+    while(maxFlow >= 0) {
+        for(int i = 0;i < n;i++) parent[i] = -1;
+        int front = 0,rear = 0;
+        queue[rear++] = start;
+        parent[start] = -2;
+        while(front < rear && parent[end] == -1) {
+            int u = queue[front++];
+            for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+                int v = G->to[e];
+                if(parent[v] == -1 && G->cap[e] > 0) {
+                    parent[v] = e;
+                    queue[rear++] = v;
+                }
+            }
+        }
+        if(parent[end] == -1) break;
+        int pathFlow = G->cap[parent[end]];
+        for(int v = end;v != start;v = G->to[G->rev[parent[v]]]) {
+            pathFlow = Min(pathFlow,G->cap[parent[v]]);
+        }
+        for(int v = end;v != start;v = G->to[G->rev[parent[v]]]) {
+            G->cap[parent[v]] -= pathFlow;
+            G->cap[G->rev[parent[v]]] += pathFlow;
+        }
+        maxFlow += pathFlow;
+    }
+    free(parent);
+    free(queue);
+    return maxFlow;
+}
+
+/* Dinic******************************************* */
+// BFS建分层图，汇点不可达返回0
+int DinicBFS(FlowGraph *G,int start,int end,int *level,int *queue) {
+    for(int i = 0;i < G->numNodes;i++) level[i] = -1;
+    int front = 0,rear = 0;
+    queue[rear++] = start;
+    level[start] = 0;
+    while(front < rear) {
+        int u = queue[front++];
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            int v = G->to[e];
+            if(level[v] == -1 && G->cap[e] > 0) {
+                level[v] = level[u] + 1;
+                queue[rear++] = v;
+            }
+        }
+    }
+    return level[end] != -1;
+}
+//非递归阻塞流：path[]为当前路径上的弧，it[u]为u的当前弧，走不通的点level置-1不再访问
+long long DinicBlock(FlowGraph *G,int start,int end,int *level,int *it,int *path) {
+    long long flow = 0;
+    int depth = 0,u = start;
+    while(1) {
+        if(u == end) {
+            //找路径上最小残量并增广
+            int pathFlow = G->cap[path[0]];
+            for(int i = 1;i < depth;i++) {
+                pathFlow = Min(pathFlow,G->cap[path[i]]);
+            }
+            int back = depth;
+            for(int i = 0;i < depth;i++) {
+                G->cap[path[i]] -= pathFlow;
+                G->cap[G->rev[path[i]]] += pathFlow;
+                if(G->cap[path[i]] == 0 && back == depth) back = i;
+            }
+            flow += pathFlow;
+            //退回到第一条饱和弧的起点
+            depth = back;
+            u = depth == 0 ? start : G->to[path[depth - 1]];
+            continue;
+        }
+        //前进：沿当前弧找下一层的点
+        int e = it[u];
+        while(e < G->offset[u + 1] && (G->cap[e] == 0 || level[G->to[e]] != level[u] + 1)) {
+            e++;
+        }
+        it[u] = e;
+        if(e < G->offset[u + 1]) {
+            path[depth++] = e;
+            u = G->to[e];
+        } else {
+            //后退：u走不通
+            level[u] = -1;
+            if(depth == 0) break;
+            depth--;
+            u = G->to[G->rev[path[depth]]];
+            it[u]++;
+        }
+    }
+    return flow;
+}
+
+long long Dinic(FlowGraph *G,int start,int end) {
+    if(start == end) return 0;
+    int n = G->numNodes;
+    int *level = (int*)malloc(sizeof(int) * n);
+    int *queue = (int*)malloc(sizeof(int) * n);
+    int *it = (int*)malloc(sizeof(int) * n);
+    int *path = (int*)malloc(sizeof(int) * n);
+    long long maxFlow = 0;
+    if(!level || !queue || !it || !path) maxFlow = -1;
+    while(maxFlow >= 0 && DinicBFS(G,start,end,level,queue)) {
+        for(int i = 0;i < n;i++) it[i] = G->offset[i];
+        maxFlow += DinicBlock(G,start,end,level,it,path);
+    }
+    free(level);
+    free(queue);
+    free(it);
+    free(path);
+    return maxFlow;
+}
+
+/* 最高标号预流推进(HLPP)************************** */
+/*
+height[u]为标号，excess[u]为超额流，有超额流的点为活跃点
+活跃点按标号放入桶(bucket)中，每次取最高标号的点推进(discharge)：
+  沿当前弧向height低1的点推流，当前弧用完则重标号为 min(邻点标号)+1
+gap优化：若某个标号h上的点全部离开(cnt[h]为0)，标号大于h的点都不可能再到汇点，直接抬高到n+1
+*/
+long long HLPP(FlowGraph *G,int start,int end) {
+    if(start == end) return 0;
+    int n = G->numNodes;
+    int *height = (int*)calloc(n,sizeof(int));
+    long long *excess = (long long*)calloc(n,sizeof(long long));
+    int *cnt = (int*)calloc(2 * n + 1,sizeof(int)); // 每个标号上的点数
+    int *bucket = (int*)malloc(sizeof(int) * (2 * n + 1)); // 各标号活跃点链表头
+    int *bnext = (int*)malloc(sizeof(int) * n);
+    int *it = (int*)malloc(sizeof(int) * n);
+    long long maxFlow = -1;
+    if(!height || !excess || !cnt || !bucket || !bnext || !it) goto done;
+    for(int i = 0;i <= 2 * n;i++) bucket[i] = -1;
+    for(int i = 0;i < n;i++) it[i] = G->offset[i];
+    height[start] = n;
+    cnt[0] = n - 1;
+    //汇点超额流置1，使它永远不会变为活跃点
+    excess[end] = 1;
+    int hi = 0;
+    //源点的边全部推满
+    for(int e = G->offset[start];e < G->offset[start + 1];e++) {
+        int v = G->to[e],f = G->cap[e];
+        if(f == 0) continue;
+        if(excess[v] == 0) {
+            bnext[v] = bucket[height[v]];
+            bucket[height[v]] = v;
+        }
+        G->cap[e] -= f;
+        G->cap[G->rev[e]] += f;
+        excess[v] += f;
+        excess[start] -= f;
+    }
+    while(1) {
+        while(bucket[hi] == -1) {
+            if(hi == 0) goto drained;
+            hi--;
+        }
+        int u = bucket[hi];
+        bucket[hi] = bnext[u];
+        //推进u直到没有超额流
+        while(excess[u] > 0) {
+            if(it[u] == G->offset[u + 1]) {
+                //重标号
+                int old = height[u];
+                height[u] = 2 * n;
+                for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+                    if(G->cap[e] > 0 && height[G->to[e]] + 1 < height[u]) {
+                        height[u] = height[G->to[e]] + 1;
+                        it[u] = e;
+                    }
+                }
+                cnt[height[u]]++;
+                cnt[old]--;
+                //gap
+                if(cnt[old] == 0 && old < n) {
+                    for(int i = 0;i < n;i++) {
+                        if(height[i] > old && height[i] < n) {
+                            cnt[height[i]]--;
+                            height[i] = n + 1;
+                            cnt[height[i]]++;
+                        }
+                    }
+                }
+                hi = height[u];
+            } else {
+                int e = it[u],v = G->to[e];
+                if(G->cap[e] > 0 && height[u] == height[v] + 1) {
+                    int f = G->cap[e] < excess[u] ? G->cap[e] : (int)excess[u];
+                    if(excess[v] == 0) {
+                        bnext[v] = bucket[height[v]];
+                        bucket[height[v]] = v;
+                    }
+                    G->cap[e] -= f;
+                    G->cap[G->rev[e]] += f;
+                    excess[v] += f;
+                    excess[u] -= f;
+                } else {
+                    it[u]++;
+                }
+            }
+        }
+    }
+drained:
+    maxFlow = -excess[start];
+done:
+    free(height);
+    free(excess);
+    free(cnt);
+    free(bucket);
+    free(bnext);
+    free(it);
+    return maxFlow;
+}
+
+/* 最小割****************************************** */
+//side[i]为1表示i在源点一侧，cutEdges存割边的输入边编号，返回割边条数，内存不足返回-1
+int MinCut(FlowGraph *G,int start,char *side,int *cutEdges) {
+    int n = G->numNodes;
+    int *queue = (int*)malloc(sizeof(int) * n);
+    if(!queue) return -1;
+    for(int i = 0;i < n;i++) side[i] = 0;
+    int front = 0,rear = 0;
+    queue[rear++] = start;
+    side[start] = 1;
+    while(front < rear) {
+        int u = queue[front++];
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            if(G->cap[e] > 0 && !side[G->to[e]]) {
+                side[G->to[e]] = 1;
+                queue[rear++] = G->to[e];
+            }
+        }
+    }
+    free(queue);
+    int count = 0;
+    for(int u = 0;u < n;u++) {
+        if(!side[u]) continue;
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            if(G->id[e] != -1 && !side[G->to[e]]) {
+                cutEdges[count++] = G->id[e];
+            }
+        }
+    }
+    return count;
+}
+
+/* 测试******************************************** */
+typedef long long (*MaxFlowFunc)(FlowGraph *G,int start,int end);
+
+void Bench(const char *name,MaxFlowFunc func,FlowGraph *G,int start,int end) {
+    ResetFlow(G);
+    clock_t begin = clock();
+    long long flow = func(G,start,end);
+    printf("%-12s flow=%lld time=%.3fs\n",name,flow,(double)(clock() - begin) / CLOCKS_PER_SEC);
+}
+
+int main() {
+    /*示例网络(6个点 10条边，源点1 汇点6)
+    1->2:16 1->3:13 2->3:10 3->2:4 2->4:12 4->3:9 3->5:14 5->4:7 4->6:20 5->6:4
+    最大流 23
+    */
+    int from[] = {0,0,1,2,1,3,2,4,3,4};
+    int to[]   = {1,2,2,1,3,2,4,3,5,5};
+    int cap[]  = {16,13,10,4,12,9,14,7,20,4};
+    FlowGraph G;
+    if(!BuildFlowGraph(&G,6,10,from,to,cap)) return 1;
+    printf("EdmondsKarp %lld\n",EdmondsKarp(&G,0,5));
+    ResetFlow(&G);
+    printf("Dinic %lld\n",Dinic(&G,0,5));
+    ResetFlow(&G);
+    printf("HLPP %lld\n",HLPP(&G,0,5));
+    char side[6];
+    int cutEdges[10];
+    int count = MinCut(&G,0,side,cutEdges);
+    printf("MinCut:");
+    for(int i = 0;i < count;i++) {
+        int k = cutEdges[i];
+        printf(" <%d-%d>:%d",from[k]+1,to[k]+1,cap[k]);
+    }
+    printf("\n");
+    ResetFlow(&G);
+    printf("start == end: %lld %lld %lld\n",EdmondsKarp(&G,2,2),Dinic(&G,2,2),HLPP(&G,2,2));
+    FreeFlowGraph(&G);
+
+    //随机分层网络：源点连第一层，每层的点随机连下一层的5个点，最后一层连汇点，对比三种算法
+    printf("\n*******\n");
+    int layers = 20,width = 200,deg = 5;
+    int n = layers * width + 2,m = 2 * width + (layers - 1) * width * deg;
+    int *f = (int*)malloc(sizeof(int) * m);
+    int *t = (int*)malloc(sizeof(int) * m);
+    int *c = (int*)malloc(sizeof(int) * m);
+    if(!f || !t || !c) return 1;
+    int k = 0;
+    srand(2024);
+    for(int i = 0;i < width;i++) {
+        f[k] = 0; t[k] = 1 + i; c[k++] = 1000000;
+        f[k] = 1 + (layers - 1) * width + i; t[k] = n - 1; c[k++] = 1000000;
+    }
+    for(int l = 0;l + 1 < layers;l++) {
+        for(int i = 0;i < width;i++) {
+            for(int d = 0;d < deg;d++) {
+                f[k] = 1 + l * width + i;
+                t[k] = 1 + (l + 1) * width + rand() % width;
+                c[k++] = rand() % 1000 + 1;
+            }
+        }
+    }
+    int built = BuildFlowGraph(&G,n,m,f,t,c);
+    free(f);
+    free(t);
+    free(c);
+    if(!built) return 1;
+    printf("V=%d E=%d\n",n,m);
+    Bench("EdmondsKarp",EdmondsKarp,&G,0,n - 1);
+    Bench("Dinic",Dinic,&G,0,n - 1);
+    Bench("HLPP",HLPP,&G,0,n - 1);
+    FreeFlowGraph(&G);
+    return 0;
+}
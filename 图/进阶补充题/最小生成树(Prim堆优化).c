@@ -0,0 +1,309 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../CSR.h"
+/*
+最小生成树-Prim堆优化
+图-邻接矩阵.c中的Prim每次线性扫描lowcost[]找最小边，O(V^2)，且邻接矩阵放不下稀疏大图
+这里在CSR上用堆找最小边，O(E log V)：
+1 懒删除堆：每条可用边都入堆，弹出时若终点已在树中则丢弃(堆中最多E个元素)
+2 索引堆：每个顶点只在堆中出现一次，lowcost变小时就地上浮(decrease-key)，堆中最多V个元素
+结果为最小生成树的边表和总权值，若图不连通则得到最小生成森林
+*/
+typedef struct {
+    int begin,end,weight;
+} MSTEdge;
+
+typedef struct {
+    MSTEdge *edges; // 最多numNodes-1条
+    int count;
+    long long total; // 总权值
+} MST;
+
+int InitMST(MST *T,int numNodes) {
+    T->edges = (MSTEdge*)malloc(sizeof(MSTEdge) * (numNodes > 1 ? numNodes - 1 : 1));
+    T->count = 0;
+    T->total = 0;
+    return T->edges != NULL;
+}
+
+void FreeMST(MST *T) {
+    free(T->edges);
+    T->edges = NULL;
+    T->count = 0;
+}
+
+void AddMSTEdge(MST *T,int begin,int end,int weight) {
+    T->edges[T->count].begin = begin;
+    T->edges[T->count].end = end;
+    T->edges[T->count].weight = weight;
+    T->count++;
+    T->total += weight;
+}
+
+/* 1 懒删除堆************************************** */
+typedef struct {
+    int key; // 边权
+    int vex; // 边的终点(待纳入树的点)
+    int from; // 边的起点(树中的点)
+} HeapNode;
+
+typedef struct {
+    HeapNode *data;
+    int size;
+} MinHeap;
+
+void SwapNode(HeapNode *a,HeapNode *b) {
+    HeapNode t = *a;
+    *a = *b;
+    *b = t;
+}
+// 上浮
+void PushHeap(MinHeap *h,HeapNode node) {
+    int i = h->size++;
+    h->data[i] = node;
+    while(i > 0) {
+        int parent = (i - 1) / 2;
+        if(h->data[i].key >= h->data[parent].key) {
+            break;
+        }
+        SwapNode(&h->data[i],&h->data[parent]);
+        i = parent;
+    }
+}
+// 下沉
+HeapNode PopHeap(MinHeap *h) {
+    HeapNode top = h->data[0];
+    h->size--;
+    h->data[0] = h->data[h->size];
+    int i = 0;
+    while(2*i + 1 < h->size) {
+        int l = 2*i + 1,r = 2*i + 2;
+        int minChild = l;
+        if(r < h->size && h->data[r].key < h->data[l].key) {
+            minChild = r;
+        }
+        if(h->data[i].key <= h->data[minChild].key) {
+            break;
+        }
+        SwapNode(&h->data[i],&h->data[minChild]);
+        i = minChild;
+    }
+    return top;
+}
+
+int PrimLazy(const CSRGraph *G,MST *T) {
+    if(!InitMST(T,G->numNodes)) return 0;
+    MinHeap h;
+    // 每条有向边最多入堆一次
+    h.data = (HeapNode*)malloc(sizeof(HeapNode) * (G->numEdges + 1));
+    h.size = 0;
+    char *inTree = (char*)calloc(G->numNodes,1);
+    if(!h.data || !inTree) {
+        free(h.data);
+        free(inTree);
+        FreeMST(T);
+        return 0;
+    }
+    // 对每个未纳入的点重新开始，得到最小生成森林
+    for(int root = 0;root < G->numNodes;root++) {
+        if(inTree[root]) continue;
+        HeapNode start = {0,root,-1};
+        PushHeap(&h,start);
+        while(h.size > 0) {
+            HeapNode E = PopHeap(&h);
+            // 懒删除：终点已在树中，说明是过期的边
+            if(inTree[E.vex]) continue;
+            inTree[E.vex] = 1;
+            if(E.from != -1) {
+                AddMSTEdge(T,E.from,E.vex,E.key);
+            }
+            for(int e = G->offset[E.vex];e < G->offset[E.vex + 1];e++) {
+                int k = G->adj[e];
+                if(!inTree[k]) {
+                    HeapNode next = {G->weight[e],k,E.vex};
+                    PushHeap(&h,next);
+                }
+            }
+        }
+    }
+    free(h.data);
+    free(inTree);
+    return 1;
+}
+
+/* 2 索引堆(decrease-key)************************** */
+//heap[]存顶点，pos[v]为顶点v在heap中的下标(-1不在堆中)，key[v]即邻接矩阵版的lowcost[v]
+typedef struct {
+    int *heap;
+    int *pos;
+    int *key;
+    int size;
+} IndexHeap;
+
+void SwapIndex(IndexHeap *h,int i,int j) {
+    int t = h->heap[i];
+    h->heap[i] = h->heap[j];
+    h->heap[j] = t;
+    h->pos[h->heap[i]] = i;
+    h->pos[h->heap[j]] = j;
+}
+// 上浮
+void SiftUp(IndexHeap *h,int i) {
+    while(i > 0) {
+        int parent = (i - 1) / 2;
+        if(h->key[h->heap[i]] >= h->key[h->heap[parent]]) {
+            break;
+        }
+        SwapIndex(h,i,parent);
+        i = parent;
+    }
+}
+// 下沉
+void SiftDown(IndexHeap *h,int i) {
+    while(2*i + 1 < h->size) {
+        int l = 2*i + 1,r = 2*i + 2;
+        int minChild = l;
+        if(r < h->size && h->key[h->heap[r]] < h->key[h->heap[l]]) {
+            minChild = r;
+        }
+        if(h->key[h->heap[i]] <= h->key[h->heap[minChild]]) {
+            break;
+        }
+        SwapIndex(h,i,minChild);
+        i = minChild;
+    }
+}
+//顶点v不在堆中则插入，在堆中且新key更小则上浮
+void DecreaseKey(IndexHeap *h,int v,int key) {
+    if(h->pos[v] == -1) {
+        h->key[v] = key;
+        h->heap[h->size] = v;
+        h->pos[v] = h->size;
+        h->size++;
+        SiftUp(h,h->pos[v]);
+    } else if(key < h->key[v]) {
+        h->key[v] = key;
+        SiftUp(h,h->pos[v]);
+    }
+}
+
+int PopMin(IndexHeap *h) {
+    int top = h->heap[0];
+    h->size--;
+    if(h->size > 0) {
+        h->heap[0] = h->heap[h->size];
+        h->pos[h->heap[0]] = 0;
+        SiftDown(h,0);
+    }
+    h->pos[top] = -1;
+    return top;
+}
+
+int PrimIndexed(const CSRGraph *G,MST *T) {
+    int n = G->numNodes;
+    if(!InitMST(T,n)) return 0;
+    IndexHeap h;
+    h.heap = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    h.pos = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    h.key = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    h.size = 0;
+    //adjvex[v]与邻接矩阵版含义相同：树中与v相连的点
+    int *adjvex = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    char *inTree = (char*)calloc(n > 0 ? n : 1,1);
+    if(!h.heap || !h.pos || !h.key || !adjvex || !inTree) {
+        free(h.heap);
+        free(h.pos);
+        free(h.key);
+        free(adjvex);
+        free(inTree);
+        FreeMST(T);
+        return 0;
+    }
+    for(int i = 0;i < n;i++) {
+        h.pos[i] = -1;
+        adjvex[i] = -1;
+    }
+    for(int root = 0;root < n;root++) {
+        if(inTree[root]) continue;
+        DecreaseKey(&h,root,0);
+        while(h.size > 0) {
+            int k = PopMin(&h);
+            inTree[k] = 1;
+            if(adjvex[k] != -1) {
+                AddMSTEdge(T,adjvex[k],k,h.key[k]);
+            }
+            for(int e = G->offset[k];e < G->offset[k + 1];e++) {
+                int j = G->adj[e];
+                //对于未纳入生成树的顶点j，且k到j的边权值更小时更新
+                if(!inTree[j] && (h.pos[j] == -1 || G->weight[e] < h.key[j])) {
+                    adjvex[j] = k;
+                    DecreaseKey(&h,j,G->weight[e]);
+                }
+            }
+        }
+    }
+    free(h.heap);
+    free(h.pos);
+    free(h.key);
+    free(adjvex);
+    free(inTree);
+    return 1;
+}
+
+void PrintMST(MST T) {
+    for(int i = 0;i < T.count;i++) {
+        printf("(%d,%d) Weight %d\n",T.edges[i].begin+1,T.edges[i].end+1,T.edges[i].weight);
+    }
+    printf("Total weight %lld\n",T.total);
+}
+
+int main() {
+    /*示例图(9个点 15条边)
+    1-2:10 1-6:11 2-3:18 2-7:16 2-9:12 3-4:22 3-9:8 4-5:20
+    4-7:24 4-8:16 4-9:21 5-6:26 5-8:7 6-7:17 7-8:19
+    最小生成树总权值 99
+    */
+    int from[] = {0,0,1,1,1,2,2,3,3,3,3,4,4,5,6};
+    int to[]   = {1,5,2,6,8,3,8,4,6,7,8,5,7,6,7};
+    int w[]    = {10,11,18,16,12,22,8,20,24,16,21,26,7,17,19};
+    CSRGraph G;
+    MST T;
+    BuildCSR(&G,9,15,from,to,w,1);
+    PrimLazy(&G,&T);
+    PrintMST(T);
+    FreeMST(&T);
+    printf("\n*******\n");
+    PrimIndexed(&G,&T);
+    PrintMST(T);
+    FreeMST(&T);
+    FreeCSR(&G);
+
+    //稀疏大图：邻接矩阵需要n*n个int，这里只需要O(V+E)
+    printf("\n*******\n");
+    int n = 1000000,m = 4000000;
+    int *f = (int*)malloc(sizeof(int) * m);
+    int *t = (int*)malloc(sizeof(int) * m);
+    int *ww = (int*)malloc(sizeof(int) * m);
+    srand(2024);
+    for(int i = 0;i < m;i++) {
+        //前n-1条边连成一条链保证连通
+        f[i] = i < n - 1 ? i : rand() % n;
+        t[i] = i < n - 1 ? i + 1 : rand() % n;
+        ww[i] = rand() % 1000 + 1;
+    }
+    BuildCSR(&G,n,m,f,t,ww,1);
+    free(f);
+    free(t);
+    free(ww);
+    clock_t begin = clock();
+    PrimLazy(&G,&T);
+    printf("Lazy    V=%d E=%d edges=%d total=%lld time=%.3fs\n",n,m,T.count,T.total,(double)(clock() - begin) / CLOCKS_PER_SEC);
+    FreeMST(&T);
+    begin = clock();
+    PrimIndexed(&G,&T);
+    printf("Indexed V=%d E=%d edges=%d total=%lld time=%.3fs\n",n,m,T.count,T.total,(double)(clock() - begin) / CLOCKS_PER_SEC);
+    FreeMST(&T);
+    FreeCSR(&G);
+    return 0;
+}
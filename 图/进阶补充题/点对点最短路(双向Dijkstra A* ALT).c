@@ -0,0 +1,396 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "../CSR.h"
+/*
+点对点最短路：只要s到t一条路径时，不必像Dijkstra(MGraph G,int v0)那样求出整棵最短路径树
+1 单向Dijkstra：弹出t就停
+2 双向Dijkstra：从s正向、从t在反图上同时搜，每次扩展堆顶较小的一侧，
+  记录相遇时的最短 best = dist_s[u] + w + dist_t[v]，两侧堆顶之和 >= best 时停止
+3 A*：优先级为 dist[v] + h(v)，h为到t距离的下界
+  坐标启发：边权不小于两端点的直线距离时，h(v) = 直线距离(v,t)
+  ALT(地标+三角不等式)：预先从几个地标L正反各做一次Dijkstra，
+  h(v) = max over L { d(L,t)-d(L,v), d(v,L)-d(t,L) }，不需要坐标
+每次查询用时间戳区分数组内容是否属于本次查询，不用O(V)清空
+*/
+#define INF 0x3fffffff
+
+typedef struct {
+    int key,vex;
+} HeapNode;
+//懒删除小顶堆：同一顶点可以重复入堆，弹出时已确定的跳过
+typedef struct {
+    HeapNode *data;
+    int size,capacity;
+} MinHeap;
+
+//扩容失败返回0，原有元素不变
+int HeapPush(MinHeap *H,int key,int vex) {
+    if(H->size == H->capacity) {
+        int capacity = H->capacity ? H->capacity * 2 : 1024;
+        HeapNode *grown = (HeapNode*)realloc(H->data,sizeof(HeapNode) * capacity);
+        if(!grown) return 0;
+        H->data = grown;
+        H->capacity = capacity;
+    }
+    int i = H->size++;
+    while(i > 0 && H->data[(i - 1) / 2].key > key) {
+        H->data[i] = H->data[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    H->data[i].key = key;
+    H->data[i].vex = vex;
+    return 1;
+}
+
+HeapNode HeapPop(MinHeap *H) {
+    HeapNode top = H->data[0],last = H->data[--H->size];
+    int i = 0;
+    while(2 * i + 1 < H->size) {
+        int c = 2 * i + 1;
+        if(c + 1 < H->size && H->data[c + 1].key < H->data[c].key) c++;
+        if(H->data[c].key >= last.key) break;
+        H->data[i] = H->data[c];
+        i = c;
+    }
+    if(H->size > 0) H->data[i] = last;
+    return top;
+}
+
+enum { HEURISTIC_NONE,HEURISTIC_COORD,HEURISTIC_ALT };
+
+typedef struct {
+    const CSRGraph *G,*R; // 正图与反图
+    const double *x,*y;   // 坐标，可为NULL
+    int numLandmarks;
+    int *landmark;
+    int *fromL,*toL; // fromL[l*n+v] = d(地标l,v)，toL[l*n+v] = d(v,地标l)
+    //两个方向的临时数组，seen[d][v] == stamp 时dist/parent有效，done[d][v] == stamp 时已确定
+    int *dist[2],*parent[2];
+    unsigned *seen[2],*done[2];
+    unsigned stamp;
+    MinHeap heap[2];
+    int meet; // 双向搜索的相遇点
+    long long settled; // 上次查询确定的顶点数
+} PathQuery;
+
+int InitPathQuery(PathQuery *Q,const CSRGraph *G,const CSRGraph *R,const double *x,const double *y) {
+    int n = G->numNodes > 0 ? G->numNodes : 1;
+    memset(Q,0,sizeof(PathQuery));
+    Q->G = G;
+    Q->R = R;
+    Q->x = x;
+    Q->y = y;
+    for(int d = 0;d < 2;d++) {
+        Q->dist[d] = (int*)malloc(sizeof(int) * n);
+        Q->parent[d] = (int*)malloc(sizeof(int) * n);
+        Q->seen[d] = (unsigned*)calloc(n,sizeof(unsigned));
+        Q->done[d] = (unsigned*)calloc(n,sizeof(unsigned));
+        if(!Q->dist[d] || !Q->parent[d] || !Q->seen[d] || !Q->done[d]) return 0;
+    }
+    return 1;
+}
+
+void FreePathQuery(PathQuery *Q) {
+    for(int d = 0;d < 2;d++) {
+        free(Q->dist[d]); free(Q->parent[d]); free(Q->seen[d]); free(Q->done[d]);
+        free(Q->heap[d].data);
+    }
+    free(Q->landmark); free(Q->fromL); free(Q->toL);
+}
+//开始新查询：时间戳加一，回绕时才真正清零
+void NewQuery(PathQuery *Q) {
+    if(++Q->stamp == 0) {
+        int n = Q->G->numNodes;
+        for(int d = 0;d < 2;d++) {
+            memset(Q->seen[d],0,sizeof(unsigned) * n);
+            memset(Q->done[d],0,sizeof(unsigned) * n);
+        }
+        Q->stamp = 1;
+    }
+    Q->heap[0].size = Q->heap[1].size = 0;
+    Q->settled = 0;
+    Q->meet = -1;
+}
+
+int GetDist(const PathQuery *Q,int d,int v) {
+    return Q->seen[d][v] == Q->stamp ? Q->dist[d][v] : INF;
+}
+//松弛：d方向上到v的距离变为nd，父结点u
+int Relax(PathQuery *Q,int d,int v,int nd,int u) {
+    if(GetDist(Q,d,v) <= nd) return 0;
+    Q->seen[d][v] = Q->stamp;
+    Q->dist[d][v] = nd;
+    Q->parent[d][v] = u;
+    return 1;
+}
+
+/* 启发函数 ***************************************** */
+int Heuristic(const PathQuery *Q,int mode,int v,int t) {
+    if(mode == HEURISTIC_COORD) {
+        double dx = Q->x[v] - Q->x[t],dy = Q->y[v] - Q->y[t];
+        return (int)sqrt(dx * dx + dy * dy);
+    }
+    if(mode == HEURISTIC_ALT) {
+        int n = Q->G->numNodes,h = 0;
+        for(int l = 0;l < Q->numLandmarks;l++) {
+            const int *from = Q->fromL + (size_t)l * n,*to = Q->toL + (size_t)l * n;
+            //到不了的地标不提供信息
+            if(from[t] < INF && from[v] < INF && from[t] - from[v] > h) h = from[t] - from[v];
+            if(to[v] < INF && to[t] < INF && to[v] - to[t] > h) h = to[v] - to[t];
+        }
+        return h;
+    }
+    return 0;
+}
+
+/* 查询 ********************************************* */
+//单向Dijkstra或A*(mode为启发方式)，返回s到t的距离，不可达返回INF，堆扩容失败返回-1
+int QueryAStar(PathQuery *Q,int s,int t,int mode) {
+    const CSRGraph *G = Q->G;
+    NewQuery(Q);
+    Relax(Q,0,s,0,-1);
+    if(!HeapPush(&Q->heap[0],Heuristic(Q,mode,s,t),s)) return -1;
+    while(Q->heap[0].size) {
+        int u = HeapPop(&Q->heap[0]).vex;
+        if(Q->done[0][u] == Q->stamp) continue;
+        Q->done[0][u] = Q->stamp;
+        Q->settled++;
+        if(u == t) return Q->dist[0][t];
+        int du = Q->dist[0][u];
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            int v = G->adj[e];
+            if(Q->done[0][v] != Q->stamp && Relax(Q,0,v,du + G->weight[e],u) &&
+               !HeapPush(&Q->heap[0],du + G->weight[e] + Heuristic(Q,mode,v,t),v)) return -1;
+        }
+    }
+    return INF;
+}
+
+int QueryDijkstra(PathQuery *Q,int s,int t) {
+    return QueryAStar(Q,s,t,HEURISTIC_NONE);
+}
+
+//双向Dijkstra，返回值同QueryAStar
+int QueryBiDijkstra(PathQuery *Q,int s,int t) {
+    NewQuery(Q);
+    Relax(Q,0,s,0,-1);
+    Relax(Q,1,t,0,-1);
+    if(!HeapPush(&Q->heap[0],0,s) || !HeapPush(&Q->heap[1],0,t)) return -1;
+    int best = s == t ? 0 : INF;
+    if(s == t) Q->meet = s;
+    while(Q->heap[0].size && Q->heap[1].size) {
+        if(Q->heap[0].data[0].key + Q->heap[1].data[0].key >= best) break;
+        //扩展堆顶较小的一侧
+        int d = Q->heap[0].data[0].key <= Q->heap[1].data[0].key ? 0 : 1;
+        const CSRGraph *G = d == 0 ? Q->G : Q->R;
+        int u = HeapPop(&Q->heap[d]).vex;
+        if(Q->done[d][u] == Q->stamp) continue;
+        Q->done[d][u] = Q->stamp;
+        Q->settled++;
+        int du = Q->dist[d][u];
+        for(int e = G->offset[u];e < G->offset[u + 1];e++) {
+            int v = G->adj[e],nd = du + G->weight[e];
+            if(Relax(Q,d,v,nd,u) && !HeapPush(&Q->heap[d],nd,v)) return -1;
+            //v已被另一侧到达，得到一条s-t路径
+            int other = GetDist(Q,1 - d,v);
+            if(other < INF && nd + other < best) {
+                best = nd + other;
+                Q->meet = v;
+            }
+        }
+    }
+    return best;
+}
+
+//取出上次查询(终点为t)的路径，返回顶点数(不可达为0)
+int GetPath(const PathQuery *Q,int t,int *path) {
+    int count = 0;
+    int v = Q->meet >= 0 ? Q->meet : t;
+    if(GetDist(Q,0,v) >= INF) return 0;
+    //正向部分：从v沿parent回到s，再反转
+    for(int u = v;u != -1;u = Q->parent[0][u]) path[count++] = u;
+    for(int i = 0,j = count - 1;i < j;i++,j--) {
+        int tmp = path[i];
+        path[i] = path[j];
+        path[j] = tmp;
+    }
+    //反向部分：双向搜索时从相遇点沿反图的parent走到t
+    if(Q->meet >= 0) {
+        for(int u = Q->parent[1][v];u != -1;u = Q->parent[1][u]) path[count++] = u;
+    }
+    return count;
+}
+
+/* 地标 ********************************************* */
+//在图D上从s做完整Dijkstra，结果写入dist(不可达为INF)，堆扩容失败返回0
+int FullDijkstra(PathQuery *Q,const CSRGraph *D,int s,int *dist) {
+    for(int v = 0;v < D->numNodes;v++) dist[v] = INF;
+    MinHeap *H = &Q->heap[0];
+    H->size = 0;
+    dist[s] = 0;
+    if(!HeapPush(H,0,s)) return 0;
+    while(H->size) {
+        HeapNode top = HeapPop(H);
+        int u = top.vex;
+        if(top.key > dist[u]) continue;
+        for(int e = D->offset[u];e < D->offset[u + 1];e++) {
+            int v = D->adj[e];
+            if(dist[u] + D->weight[e] < dist[v]) {
+                dist[v] = dist[u] + D->weight[e];
+                if(!HeapPush(H,dist[v],v)) return 0;
+            }
+        }
+    }
+    return 1;
+}
+//最远点法选k个地标：每次取离已选地标最远的顶点，地标尽量分散在图的边缘。内存不足返回0，不用地标
+int BuildLandmarks(PathQuery *Q,int k) {
+    int n = Q->G->numNodes;
+    Q->landmark = (int*)malloc(sizeof(int) * k);
+    Q->fromL = (int*)malloc(sizeof(int) * (size_t)k * n);
+    Q->toL = (int*)malloc(sizeof(int) * (size_t)k * n);
+    int *nearest = (int*)malloc(sizeof(int) * n);
+    //第一个地标取离随机起点最远的顶点，起点避开孤立点
+    int start = 0;
+    for(int tries = 0;tries < 100 && OutDegreeCSR(Q->G,start) == 0;tries++) start = rand() % n;
+    int ok = Q->landmark && Q->fromL && Q->toL && nearest && FullDijkstra(Q,Q->G,start,nearest);
+    if(!ok) {
+        free(nearest);
+        return 0;
+    }
+    int next = start;
+    for(int v = 0;v < n;v++) {
+        if(nearest[v] < INF && nearest[v] > nearest[next]) next = v;
+    }
+    for(int v = 0;v < n;v++) nearest[v] = INF;
+    for(int l = 0;l < k;l++) {
+        Q->landmark[l] = next;
+        int *from = Q->fromL + (size_t)l * n;
+        if(!FullDijkstra(Q,Q->G,next,from) || !FullDijkstra(Q,Q->R,next,Q->toL + (size_t)l * n)) {
+            free(nearest);
+            return 0;
+        }
+        for(int v = 0;v < n;v++) {
+            if(from[v] < nearest[v]) nearest[v] = from[v];
+        }
+        next = Q->landmark[l];
+        for(int v = 0;v < n;v++) {
+            if(nearest[v] < INF && nearest[v] > nearest[next]) next = v;
+        }
+    }
+    free(nearest);
+    Q->numLandmarks = k;
+    return 1;
+}
+
+/* 演示 ********************************************* */
+//道路网：rows x cols个路口，坐标在网格上随机抖动，相邻路口双向连通，
+//边权 = 直线距离 * (1~2倍的随机拥堵系数)，保证不小于直线距离
+void RoadNetwork(CSRGraph *G,CSRGraph *R,double **px,double **py,int rows,int cols) {
+    int n = rows * cols,m = 0;
+    double *x = (double*)malloc(sizeof(double) * n),*y = (double*)malloc(sizeof(double) * n);
+    for(int i = 0;i < n;i++) {
+        x[i] = (i % cols) * 100 + rand() % 60;
+        y[i] = (i / cols) * 100 + rand() % 60;
+    }
+    int *from = (int*)malloc(sizeof(int) * n * 4),*to = (int*)malloc(sizeof(int) * n * 4);
+    int *w = (int*)malloc(sizeof(int) * n * 4);
+    for(int i = 0;i < n;i++) {
+        int nb[2] = {i % cols + 1 < cols ? i + 1 : -1,i / cols + 1 < rows ? i + cols : -1};
+        for(int k = 0;k < 2;k++) {
+            int j = nb[k];
+            //约5%的路段不通
+            if(j < 0 || rand() % 100 < 5) continue;
+            double dx = x[i] - x[j],dy = y[i] - y[j];
+            int len = (int)ceil(sqrt(dx * dx + dy * dy) * (1 + (rand() % 100) / 100.0));
+            from[m] = i; to[m] = j; w[m++] = len;
+            from[m] = j; to[m] = i; w[m++] = len;
+        }
+    }
+    BuildCSR(G,n,m,from,to,w,0);
+    BuildCSR(R,n,m,to,from,w,0);
+    free(from); free(to); free(w);
+    *px = x;
+    *py = y;
+}
+
+double Elapsed(clock_t begin) {
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    CSRGraph G,R;
+    double *x,*y;
+    PathQuery Q;
+    //小例子
+    srand(2024);
+    RoadNetwork(&G,&R,&x,&y,4,5);
+    if(!InitPathQuery(&Q,&G,&R,x,y)) return 1;
+    int path[64],s = 0,t = 19;
+    int d = QueryBiDijkstra(&Q,s,t);
+    if(d < 0) return 1;
+    int count = GetPath(&Q,t,path);
+    printf("4x5 road network, %d -> %d distance %d path:",s + 1,t + 1,d);
+    for(int i = 0;i < count;i++) printf(" %d",path[i] + 1);
+    printf("\n");
+    FreePathQuery(&Q);
+    FreeCSR(&G); FreeCSR(&R); free(x); free(y);
+
+    //100万个路口
+    printf("\n*******\n");
+    RoadNetwork(&G,&R,&x,&y,1000,1000);
+    if(!InitPathQuery(&Q,&G,&R,x,y)) return 1;
+    clock_t begin = clock();
+    if(!BuildLandmarks(&Q,8)) {
+        printf("out of memory\n");
+        return 1;
+    }
+    printf("Road network n=%d m=%d, 8 landmarks time=%.3fs\n",G.numNodes,G.numEdges,Elapsed(begin));
+    int q = 100;
+    int *qs = (int*)malloc(sizeof(int) * q),*qt = (int*)malloc(sizeof(int) * q),*answer = (int*)malloc(sizeof(int) * q);
+    for(int i = 0;i < q;i++) {
+        qs[i] = (int)(((unsigned)rand() * 32768u + rand()) % G.numNodes);
+        qt[i] = (int)(((unsigned)rand() * 32768u + rand()) % G.numNodes);
+    }
+    int *buffer = (int*)malloc(sizeof(int) * G.numNodes);
+    const char *name[] = {"Dijkstra","BiDijkstra","A* coord","A* ALT"};
+    for(int method = 0;method < 4;method++) {
+        long long settled = 0;
+        int wrong = 0;
+        begin = clock();
+        for(int i = 0;i < q;i++) {
+            if(method == 0) d = QueryDijkstra(&Q,qs[i],qt[i]);
+            else if(method == 1) d = QueryBiDijkstra(&Q,qs[i],qt[i]);
+            else d = QueryAStar(&Q,qs[i],qt[i],method == 2 ? HEURISTIC_COORD : HEURISTIC_ALT);
+            if(d < 0) {
+                printf("out of memory\n");
+                return 1;
+            }
+            settled += Q.settled;
+            if(method == 0) answer[i] = d;
+            else wrong += d != answer[i];
+            //路径长度与距离一致
+            count = GetPath(&Q,qt[i],buffer);
+            int len = 0;
+            for(int k = 0;k + 1 < count;k++) {
+                for(int e = G.offset[buffer[k]];e < G.offset[buffer[k] + 1];e++) {
+                    if(G.adj[e] == buffer[k + 1]) {
+                        len += G.weight[e];
+                        break;
+                    }
+                }
+            }
+            if(d < INF && len != d) wrong++;
+        }
+        double time = Elapsed(begin);
+        printf("%-10s %3d queries avg settled %8lld avg time %.3fms wrong %d\n",name[method],q,settled / q,
+               time * 1000 / q,wrong);
+    }
+    free(qs); free(qt); free(answer); free(buffer);
+    FreePathQuery(&Q);
+    FreeCSR(&G); FreeCSR(&R); free(x); free(y);
+    return 0;
+}
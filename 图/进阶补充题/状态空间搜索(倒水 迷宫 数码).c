@@ -0,0 +1,260 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "StateSearch.h"
+/*
+用StateSearch.h求解三类问题：
+1 倒水问题：状态(x,y)编码为 x*(maxY+1)+y
+2 走迷宫：状态(r,c)编码为 r*cols+c，A*用曼哈顿距离
+3 八数码/十五数码：每格4位，16格正好64位，A*与IDA*用各数码的曼哈顿距离之和
+*/
+
+/* 1 倒水问题*************************************** */
+typedef struct {
+    int maxX,maxY,target;
+} Jug;
+
+const char *jugAction[] = {
+    "把X装满","把Y装满","把X倒空","把Y倒空",
+    "把X中的水倒入Y中,X倒完,Y没有装满","把X倒入Y中,Y被装满",
+    "把Y中的水倒入X中,Y倒完,X没有装满","把Y倒入X中,X被装满"
+};
+
+int JugExpand(StateKey s,StateKey *next,int *cost,int *action,void *ctx) {
+    Jug *J = (Jug*)ctx;
+    int x = (int)(s / (J->maxY + 1)),y = (int)(s % (J->maxY + 1));
+    int nx[8],ny[8],count = 0;
+    nx[0] = J->maxX; ny[0] = y;
+    nx[1] = x; ny[1] = J->maxY;
+    nx[2] = 0; ny[2] = y;
+    nx[3] = x; ny[3] = 0;
+    nx[4] = -1; nx[5] = -1; nx[6] = -1; nx[7] = -1;
+    if(x + y <= J->maxY) { nx[4] = 0; ny[4] = x + y; }
+    else { nx[5] = x + y - J->maxY; ny[5] = J->maxY; }
+    if(x + y <= J->maxX) { nx[6] = x + y; ny[6] = 0; }
+    else { nx[7] = J->maxX; ny[7] = x + y - J->maxX; }
+    for(int i = 0;i < 8;i++) {
+        if(nx[i] == -1 || (nx[i] == x && ny[i] == y)) continue;
+        next[count] = (StateKey)nx[i] * (J->maxY + 1) + ny[i];
+        cost[count] = 1;
+        action[count] = i;
+        count++;
+    }
+    return count;
+}
+
+int JugGoal(StateKey s,void *ctx) {
+    Jug *J = (Jug*)ctx;
+    int x = (int)(s / (J->maxY + 1)),y = (int)(s % (J->maxY + 1));
+    return x == J->target || y == J->target;
+}
+
+/* 2 走迷宫***************************************** */
+typedef struct {
+    int rows,cols;
+    char *grid; // 1为墙
+    int goalR,goalC;
+} Maze;
+
+int dr[] = {-1,1,0,0},dc[] = {0,0,-1,1};
+const char *mazeAction = "WSAD"; // 上下左右，与走迷宫.c的按键一致
+
+int MazeExpand(StateKey s,StateKey *next,int *cost,int *action,void *ctx) {
+    Maze *M = (Maze*)ctx;
+    int r = (int)(s / M->cols),c = (int)(s % M->cols),count = 0;
+    for(int i = 0;i < 4;i++) {
+        int nr = r + dr[i],nc = c + dc[i];
+        if(nr < 0 || nr >= M->rows || nc < 0 || nc >= M->cols || M->grid[nr * M->cols + nc]) continue;
+        next[count] = (StateKey)nr * M->cols + nc;
+        cost[count] = 1;
+        action[count] = i;
+        count++;
+    }
+    return count;
+}
+//前驱：从前驱走到s的方向与s走到前驱的方向相反
+int MazeExpandBack(StateKey s,StateKey *prev,int *cost,int *action,void *ctx) {
+    int count = MazeExpand(s,prev,cost,action,ctx);
+    for(int i = 0;i < count;i++) action[i] ^= 1;
+    return count;
+}
+
+int MazeGoal(StateKey s,void *ctx) {
+    Maze *M = (Maze*)ctx;
+    return s == (StateKey)M->goalR * M->cols + M->goalC;
+}
+
+int MazeH(StateKey s,void *ctx) {
+    Maze *M = (Maze*)ctx;
+    int r = (int)(s / M->cols),c = (int)(s % M->cols);
+    return abs(r - M->goalR) + abs(c - M->goalC);
+}
+
+/* 3 数码问题*************************************** */
+//第i格的数字在第4i~4i+3位，0为空格，目标为 1 2 3 ... n*n-1 0
+typedef struct {
+    int n;
+    StateKey goal;
+} Puzzle;
+
+int GetCell(StateKey s,int i) {
+    return (int)((s >> (4 * i)) & 15);
+}
+
+StateKey SetCell(StateKey s,int i,int v) {
+    return (s & ~(15ULL << (4 * i))) | ((StateKey)v << (4 * i));
+}
+
+StateKey PuzzleGoalKey(int n) {
+    StateKey s = 0;
+    for(int i = 0;i < n * n - 1;i++) s = SetCell(s,i,i + 1);
+    return s;
+}
+//动作为空格移动方向
+int PuzzleExpand(StateKey s,StateKey *next,int *cost,int *action,void *ctx) {
+    Puzzle *P = (Puzzle*)ctx;
+    int n = P->n,blank = 0,count = 0;
+    while(GetCell(s,blank) != 0) blank++;
+    int r = blank / n,c = blank % n;
+    for(int i = 0;i < 4;i++) {
+        int nr = r + dr[i],nc = c + dc[i];
+        if(nr < 0 || nr >= n || nc < 0 || nc >= n) continue;
+        int k = nr * n + nc;
+        next[count] = SetCell(SetCell(s,blank,GetCell(s,k)),k,0);
+        cost[count] = 1;
+        action[count] = i;
+        count++;
+    }
+    return count;
+}
+
+int PuzzleExpandBack(StateKey s,StateKey *prev,int *cost,int *action,void *ctx) {
+    int count = PuzzleExpand(s,prev,cost,action,ctx);
+    for(int i = 0;i < count;i++) action[i] ^= 1;
+    return count;
+}
+
+int PuzzleGoal(StateKey s,void *ctx) {
+    return s == ((Puzzle*)ctx)->goal;
+}
+
+int PuzzleH(StateKey s,void *ctx) {
+    int n = ((Puzzle*)ctx)->n,h = 0;
+    for(int i = 0;i < n * n;i++) {
+        int v = GetCell(s,i);
+        if(v == 0) continue;
+        h += abs(i / n - (v - 1) / n) + abs(i % n - (v - 1) % n);
+    }
+    return h;
+}
+//从目标随机走steps步打乱，保证有解
+StateKey Shuffle(Puzzle *P,int steps) {
+    StateKey s = P->goal,prev = s,next[4];
+    int cost[4],action[4];
+    for(int i = 0;i < steps;i++) {
+        int count = PuzzleExpand(s,next,cost,action,P);
+        int k;
+        do {
+            k = rand() % count;
+        } while(next[k] == prev);
+        prev = s;
+        s = next[k];
+    }
+    return s;
+}
+
+void PrintPuzzle(StateKey s,int n) {
+    for(int i = 0;i < n * n;i++) {
+        printf("%2d%c",GetCell(s,i),i % n == n - 1 ? '\n' : ' ');
+    }
+}
+
+void Report(const char *name,SearchPath *P,clock_t begin) {
+    printf("%-8s steps=%d expanded=%lld stored=%lld time=%.3fs\n",name,P->length > 0 ? P->length - 1 : -1,
+           P->expanded,P->stored,(double)(clock() - begin) / CLOCKS_PER_SEC);
+}
+
+int main() {
+    SearchPath path;
+    clock_t begin;
+    //倒水
+    Jug J = {3,5,4};
+    Problem jug = {JugExpand,JugGoal,NULL,NULL,8,&J};
+    printf("Jug X=%d Y=%d L=%d\n",J.maxX,J.maxY,J.target);
+    if(SearchBFS(&jug,0,&path)) {
+        for(int i = 0;i + 1 < path.length;i++) {
+            printf("%s\n",jugAction[path.actions[i]]);
+        }
+    } else {
+        printf("No Solution\n");
+    }
+    FreePath(&path);
+
+    //随机迷宫，约30%为墙
+    printf("\n*******\n");
+    Maze M;
+    M.rows = M.cols = 2000;
+    M.grid = (char*)malloc(M.rows * M.cols);
+    srand(2024);
+    for(int i = 0;i < M.rows * M.cols;i++) M.grid[i] = rand() % 100 < 30;
+    M.grid[0] = 0;
+    M.goalR = M.rows - 1;
+    M.goalC = M.cols - 1;
+    M.grid[M.goalR * M.cols + M.goalC] = 0;
+    Problem maze = {MazeExpand,MazeGoal,MazeH,MazeExpandBack,4,&M};
+    StateKey goal = (StateKey)M.goalR * M.cols + M.goalC;
+    printf("Maze %dx%d\n",M.rows,M.cols);
+    begin = clock();
+    SearchBFS(&maze,0,&path);
+    Report("BFS",&path,begin);
+    FreePath(&path);
+    begin = clock();
+    SearchBiBFS(&maze,0,goal,&path);
+    Report("BiBFS",&path,begin);
+    FreePath(&path);
+    begin = clock();
+    SearchAStar(&maze,0,&path);
+    Report("A*",&path,begin);
+    if(path.length > 0) {
+        printf("First moves: ");
+        for(int i = 0;i < 20 && i + 1 < path.length;i++) printf("%c",mazeAction[path.actions[i]]);
+        printf("\n");
+    }
+    FreePath(&path);
+    free(M.grid);
+
+    //八数码
+    printf("\n*******\n");
+    Puzzle P8 = {3,PuzzleGoalKey(3)};
+    Problem puzzle8 = {PuzzleExpand,PuzzleGoal,PuzzleH,PuzzleExpandBack,4,&P8};
+    StateKey s8 = Shuffle(&P8,200);
+    PrintPuzzle(s8,3);
+    begin = clock();
+    SearchBFS(&puzzle8,s8,&path);
+    Report("BFS",&path,begin);
+    FreePath(&path);
+    begin = clock();
+    SearchBiBFS(&puzzle8,s8,P8.goal,&path);
+    Report("BiBFS",&path,begin);
+    FreePath(&path);
+    begin = clock();
+    SearchAStar(&puzzle8,s8,&path);
+    Report("A*",&path,begin);
+    FreePath(&path);
+    begin = clock();
+    SearchIDAStar(&puzzle8,s8,40,&path);
+    Report("IDA*",&path,begin);
+    FreePath(&path);
+
+    //十五数码：状态空间约10^13，只有IDA*能在有限内存里解
+    printf("\n*******\n");
+    Puzzle P15 = {4,PuzzleGoalKey(4)};
+    Problem puzzle15 = {PuzzleExpand,PuzzleGoal,PuzzleH,PuzzleExpandBack,4,&P15};
+    StateKey s15 = Shuffle(&P15,80);
+    PrintPuzzle(s15,4);
+    begin = clock();
+    SearchIDAStar(&puzzle15,s15,80,&path);
+    Report("IDA*",&path,begin);
+    FreePath(&path);
+    return 0;
+}
@@ -0,0 +1,452 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../CSR.h"
+/*
+无权无向图的直径、半径与每个顶点的偏心距(到最远顶点的距离)
+图-邻接矩阵.c的Farest()/MaxLeaf()在邻接矩阵上BFS，求直径要从每个顶点BFS一次，O(n^3)
+1 位并行多源BFS：一次最多64个源点，seen[v]的第k位表示第k个源点已到达v，
+  一层扩展时 D = visit[v] & ~seen[w] 一次推进64个源点，边只扫一遍
+2 双扫描/四扫描：从u出发BFS找最远点a，再从a出发BFS找最远点b，d(a,b)是直径的下界，a-b路径中点适合作iFUB的根
+3 iFUB求直径：从根u做BFS，按层从远到近算该层顶点的偏心距(每层64个一批)，
+  第i层以内的任意两点距离不超过2i，处理完第i层后若下界 >= 2(i-1) 就是直径
+4 全部偏心距(边界法)：对已求偏心距的顶点v和任意w，
+  max(d(v,w), ecc(v)-d(v,w)) <= ecc(w) <= ecc(v)+d(v,w)
+  每轮挑上界最大、下界最小的未确定顶点凑满64个做一次多源BFS，直到所有顶点上下界相等
+非连通图按连通分量分别计算，直径取各分量直径的最大值，偏心距只计同一分量内的顶点
+*/
+typedef unsigned long long u64;
+
+typedef struct {
+    const CSRGraph *G;
+    u64 *seen,*visit,*next;
+    int *frontier,*nextFrontier;
+    int *dist,*queue; // 单源BFS
+    long long bfsCount; // 共做了几次BFS(多源BFS按一次算)
+} EccEngine;
+
+int Ctz(u64 x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while(!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+int InitEngine(EccEngine *E,const CSRGraph *G) {
+    int n = G->numNodes > 0 ? G->numNodes : 1;
+    E->G = G;
+    E->seen = (u64*)calloc(n,sizeof(u64));
+    E->visit = (u64*)calloc(n,sizeof(u64));
+    E->next = (u64*)calloc(n,sizeof(u64));
+    E->frontier = (int*)malloc(sizeof(int) * n);
+    E->nextFrontier = (int*)malloc(sizeof(int) * n);
+    E->dist = (int*)malloc(sizeof(int) * n);
+    E->queue = (int*)malloc(sizeof(int) * n);
+    E->bfsCount = 0;
+    if(!E->seen || !E->visit || !E->next || !E->frontier || !E->nextFrontier || !E->dist || !E->queue) return 0;
+    for(int v = 0;v < G->numNodes;v++) E->dist[v] = -1;
+    return 1;
+}
+
+void FreeEngine(EccEngine *E) {
+    free(E->seen); free(E->visit); free(E->next);
+    free(E->frontier); free(E->nextFrontier);
+    free(E->dist); free(E->queue);
+}
+
+//单源BFS，结果在E->dist中(调用前全为-1)，E->queue[0..返回值-1]为按距离升序访问的顶点
+int BFSFrom(EccEngine *E,int s) {
+    const CSRGraph *G = E->G;
+    int head = 0,tail = 0;
+    E->bfsCount++;
+    E->dist[s] = 0;
+    E->queue[tail++] = s;
+    while(head < tail) {
+        int v = E->queue[head++];
+        for(int e = G->offset[v];e < G->offset[v + 1];e++) {
+            int w = G->adj[e];
+            if(E->dist[w] == -1) {
+                E->dist[w] = E->dist[v] + 1;
+                E->queue[tail++] = w;
+            }
+        }
+    }
+    return tail;
+}
+//把上一次BFS访问过的顶点的dist恢复为-1，O(访问的顶点数)
+void ClearBFS(EccEngine *E,int count) {
+    for(int i = 0;i < count;i++) E->dist[E->queue[i]] = -1;
+}
+
+//K(<=64)个源点同时BFS，ecc[k]为第k个源点的偏心距
+//lower、upper不为NULL时再走一遍，用这K个偏心距更新所有被到达顶点的上下界
+void MultiBFS(EccEngine *E,const int *src,int K,int *ecc,int *lower,int *upper) {
+    const CSRGraph *G = E->G;
+    for(int pass = 0;pass < (lower ? 2 : 1);pass++) {
+        int size = 0;
+        E->bfsCount++;
+        for(int k = 0;k < K;k++) {
+            int s = src[k];
+            if(!E->visit[s]) E->frontier[size++] = s;
+            E->visit[s] |= 1ULL << k;
+        }
+        if(pass == 0) {
+            for(int k = 0;k < K;k++) ecc[k] = 0;
+        } else {
+            for(int k = 0;k < K;k++) lower[src[k]] = upper[src[k]] = ecc[k];
+        }
+        int level = 0;
+        //seen在两次调用之间保持全0：被到达过的顶点记在touched里，结束时只清这些
+        int *touched = E->queue,touchedCount = 0;
+        for(int i = 0;i < size;i++) {
+            int s = E->frontier[i];
+            E->seen[s] = E->visit[s];
+            touched[touchedCount++] = s;
+        }
+        while(size) {
+            level++;
+            int nextSize = 0;
+            for(int i = 0;i < size;i++) {
+                int v = E->frontier[i];
+                u64 bits = E->visit[v];
+                for(int e = G->offset[v];e < G->offset[v + 1];e++) {
+                    int w = G->adj[e];
+                    u64 d = bits & ~E->seen[w];
+                    if(d) {
+                        if(!E->seen[w]) touched[touchedCount++] = w;
+                        if(!E->next[w]) E->nextFrontier[nextSize++] = w;
+                        E->next[w] |= d;
+                        E->seen[w] |= d;
+                    }
+                }
+                E->visit[v] = 0;
+            }
+            for(int i = 0;i < nextSize;i++) {
+                int w = E->nextFrontier[i];
+                u64 d = E->next[w];
+                if(pass == 0) {
+                    for(u64 x = d;x;x &= x - 1) ecc[Ctz(x)] = level;
+                } else {
+                    for(u64 x = d;x;x &= x - 1) {
+                        int k = Ctz(x);
+                        int lo = ecc[k] - level > level ? ecc[k] - level : level;
+                        if(lo > lower[w]) lower[w] = lo;
+                        if(ecc[k] + level < upper[w]) upper[w] = ecc[k] + level;
+                    }
+                }
+                E->visit[w] = d;
+                E->next[w] = 0;
+            }
+            int *t = E->frontier;
+            E->frontier = E->nextFrontier;
+            E->nextFrontier = t;
+            size = nextSize;
+        }
+        for(int i = 0;i < touchedCount;i++) E->seen[touched[i]] = 0;
+    }
+}
+
+/* 双扫描与iFUB ************************************** */
+//上一次BFS中距离最远的点(取最后入队的)
+int Farthest(EccEngine *E,int count) {
+    return E->queue[count - 1];
+}
+//从b沿距离递减走到距离为half的顶点(E->dist为从a出发的BFS)
+//有多个前驱时轮流选，否则网格这类图会一直贴着边走，中点落在角上
+int MiddleOf(EccEngine *E,int b,int half) {
+    const CSRGraph *G = E->G;
+    for(int step = 0;E->dist[b] > half;step++) {
+        int count = 0;
+        for(int e = G->offset[b];e < G->offset[b + 1];e++) {
+            count += E->dist[G->adj[e]] == E->dist[b] - 1;
+        }
+        int k = step % count;
+        for(int e = G->offset[b];e < G->offset[b + 1];e++) {
+            if(E->dist[G->adj[e]] == E->dist[b] - 1 && k-- == 0) {
+                b = G->adj[e];
+                break;
+            }
+        }
+    }
+    return b;
+}
+//四扫描：返回直径下界，*center为适合作iFUB根的顶点
+//根的偏心距越小，iFUB要处理的层越少，所以在起点和两个中点里取偏心距最小的
+int FourSweep(EccEngine *E,int r,int *center) {
+    int lower = 0,best = r,bestEcc = -1;
+    for(int round = 0;round < 3;round++) {
+        int count = BFSFrom(E,r);
+        int a = Farthest(E,count);
+        if(bestEcc == -1 || E->dist[a] < bestEcc) {
+            best = r;
+            bestEcc = E->dist[a];
+        }
+        ClearBFS(E,count);
+        if(round == 2) break;
+        count = BFSFrom(E,a);
+        int b = Farthest(E,count);
+        if(E->dist[b] > lower) lower = E->dist[b];
+        r = MiddleOf(E,b,E->dist[b] / 2);
+        ClearBFS(E,count);
+    }
+    *center = best;
+    return lower;
+}
+
+//r所在连通分量的直径
+int ComponentDiameter(EccEngine *E,int r) {
+    int u,lower = FourSweep(E,r,&u);
+    int count = BFSFrom(E,u);
+    int *order = (int*)malloc(sizeof(int) * count);
+    int *level = (int*)malloc(sizeof(int) * count);
+    for(int i = 0;i < count;i++) {
+        order[i] = E->queue[i];
+        level[i] = E->dist[order[i]];
+    }
+    ClearBFS(E,count);
+    int ecc[64],batch[64];
+    int i = level[count - 1],end = count;
+    if(i > lower) lower = i;
+    //第i层的顶点为order[begin..end-1]
+    while(lower < 2 * i) {
+        int begin = end;
+        while(begin > 0 && level[begin - 1] == i) begin--;
+        int bi = 0;
+        for(int j = begin;j < end;j += 64) {
+            int K = end - j < 64 ? end - j : 64;
+            memcpy(batch,order + j,sizeof(int) * K);
+            MultiBFS(E,batch,K,ecc,NULL,NULL);
+            for(int k = 0;k < K;k++) if(ecc[k] > bi) bi = ecc[k];
+        }
+        if(bi > lower) lower = bi;
+        end = begin;
+        i--;
+    }
+    free(order);
+    free(level);
+    return lower;
+}
+//整个图的直径(各连通分量取最大)，从每个分量度最大的顶点出发
+int Diameter(EccEngine *E) {
+    const CSRGraph *G = E->G;
+    char *done = (char*)calloc(G->numNodes,1);
+    int diameter = 0;
+    for(int v = 0;v < G->numNodes;v++) {
+        if(done[v]) continue;
+        int count = BFSFrom(E,v),r = v;
+        for(int i = 0;i < count;i++) {
+            int w = E->queue[i];
+            done[w] = 1;
+            if(OutDegreeCSR(G,w) > OutDegreeCSR(G,r)) r = w;
+        }
+        ClearBFS(E,count);
+        if(count <= 2) {
+            if(count - 1 > diameter) diameter = count - 1;
+            continue;
+        }
+        int d = ComponentDiameter(E,r);
+        if(d > diameter) diameter = d;
+    }
+    free(done);
+    return diameter;
+}
+
+/* 全部偏心距 *************************************** */
+//v比best更该先算：kind为0时按上界大优先，为1时按下界小优先
+int Prior(int kind,int v,int best,const int *lower,const int *upper) {
+    if(kind == 0) return upper[v] > upper[best] || (upper[v] == upper[best] && lower[v] < lower[best]);
+    return lower[v] < lower[best] || (lower[v] == lower[best] && upper[v] > upper[best]);
+}
+//把v插入按kind排好序的top[0..*size-1]，最多保留limit个
+void PushTop(int *top,int *size,int limit,int kind,int v,const int *lower,const int *upper) {
+    if(*size == limit && !Prior(kind,v,top[limit - 1],lower,upper)) return;
+    int j = *size < limit ? (*size)++ : limit - 1;
+    while(j > 0 && Prior(kind,v,top[j - 1],lower,upper)) {
+        top[j] = top[j - 1];
+        j--;
+    }
+    top[j] = v;
+}
+
+//ecc[v]为v的偏心距，返回做的多源BFS批数
+int Eccentricities(EccEngine *E,int *ecc) {
+    int n = E->G->numNodes;
+    int *lower = (int*)calloc(n,sizeof(int));
+    int *upper = (int*)malloc(sizeof(int) * n);
+    int batch[64],batchEcc[64],top[2][64],topSize[2],rounds = 0,unresolved = n;
+    for(int v = 0;v < n;v++) upper[v] = n;
+    while(unresolved) {
+        //扫一遍，挑上界最大的和下界最小的未确定顶点，轮流放进这一批
+        topSize[0] = topSize[1] = 0;
+        for(int v = 0;v < n;v++) {
+            if(lower[v] == upper[v]) continue;
+            PushTop(top[0],&topSize[0],64,0,v,lower,upper);
+            PushTop(top[1],&topSize[1],64,1,v,lower,upper);
+        }
+        int K = 0;
+        for(int i = 0;K < 64 && (i < topSize[0] || i < topSize[1]);i++) {
+            for(int kind = 0;kind < 2 && K < 64;kind++) {
+                if(i >= topSize[kind]) continue;
+                int v = top[kind][i],dup = 0;
+                for(int k = 0;k < K && !dup;k++) dup = batch[k] == v;
+                if(!dup) batch[K++] = v;
+            }
+        }
+        MultiBFS(E,batch,K,batchEcc,lower,upper);
+        rounds++;
+        unresolved = 0;
+        for(int v = 0;v < n;v++) unresolved += lower[v] != upper[v];
+    }
+    memcpy(ecc,lower,sizeof(int) * n);
+    free(lower);
+    free(upper);
+    return rounds;
+}
+
+/* 演示 ********************************************* */
+//对照：每个顶点单独BFS
+void EccentricitiesBrute(EccEngine *E,int *ecc) {
+    for(int v = 0;v < E->G->numNodes;v++) {
+        int count = BFSFrom(E,v);
+        ecc[v] = E->dist[Farthest(E,count)];
+        ClearBFS(E,count);
+    }
+}
+//随机稀疏图，看起来像网络拓扑：新顶点一半概率接到已有的随机顶点，一半概率按度数比例接(度大的顶点成为枢纽)，
+//再加extra条随机边，很多度为1的末端
+unsigned Rand32() {
+    return (unsigned)rand() * 32768u + (unsigned)rand();
+}
+
+void RandomNetwork(CSRGraph *G,int n,int extra) {
+    int m = n - 1 + extra;
+    int *from = (int*)malloc(sizeof(int) * m),*to = (int*)malloc(sizeof(int) * m);
+    for(int v = 1;v < n;v++) {
+        from[v - 1] = v;
+        //已有的边端点中随机挑一个，被挑中的概率与度数成正比
+        if(v < 2 || rand() % 2) to[v - 1] = (int)(Rand32() % v);
+        else {
+            int e = (int)(Rand32() % (v - 1));
+            to[v - 1] = rand() % 2 ? from[e] : to[e];
+        }
+    }
+    for(int i = n - 1;i < m;i++) {
+        from[i] = (int)(Rand32() % n);
+        to[i] = (int)(Rand32() % n);
+    }
+    BuildCSR(G,n,m,from,to,NULL,1);
+    free(from);
+    free(to);
+}
+
+void GridGraph(CSRGraph *G,int rows,int cols) {
+    int m = rows * (cols - 1) + (rows - 1) * cols,k = 0;
+    int *from = (int*)malloc(sizeof(int) * m),*to = (int*)malloc(sizeof(int) * m);
+    for(int r = 0;r < rows;r++) {
+        for(int c = 0;c < cols;c++) {
+            if(c + 1 < cols) { from[k] = r * cols + c; to[k++] = r * cols + c + 1; }
+            if(r + 1 < rows) { from[k] = r * cols + c; to[k++] = (r + 1) * cols + c; }
+        }
+    }
+    BuildCSR(G,rows * cols,m,from,to,NULL,1);
+    free(from);
+    free(to);
+}
+
+void Report(const char *name,const int *ecc,int n) {
+    int diameter = 0,radius = -1,center = 0,periphery = 0;
+    for(int v = 0;v < n;v++) {
+        if(ecc[v] > diameter) diameter = ecc[v];
+        //孤立点不参与半径
+        if(ecc[v] > 0 && (radius == -1 || ecc[v] < radius)) radius = ecc[v];
+    }
+    for(int v = 0;v < n;v++) {
+        center += ecc[v] == radius;
+        periphery += ecc[v] == diameter;
+    }
+    printf("%s diameter %d radius %d center %d vertices periphery %d vertices\n",name,diameter,radius,center,periphery);
+}
+
+double Elapsed(clock_t begin) {
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    CSRGraph G;
+    EccEngine E;
+    //小例子：1-2-3-4-5 加 3-6-7
+    int from[] = {0,1,2,3,2,5},to[] = {1,2,3,4,5,6};
+    BuildCSR(&G,7,6,from,to,NULL,1);
+    InitEngine(&E,&G);
+    int ecc[7];
+    Eccentricities(&E,ecc);
+    for(int v = 0;v < 7;v++) printf("ecc(%d)=%d ",v + 1,ecc[v]);
+    printf("\nDiameter %d\n",Diameter(&E));
+    FreeEngine(&E);
+    FreeCSR(&G);
+
+    //与逐点BFS对照
+    printf("\n*******\n");
+    srand(2024);
+    int n = 5000;
+    RandomNetwork(&G,n,n / 5);
+    InitEngine(&E,&G);
+    int *e1 = (int*)malloc(sizeof(int) * n),*e2 = (int*)malloc(sizeof(int) * n);
+    clock_t begin = clock();
+    EccentricitiesBrute(&E,e1);
+    printf("Brute    %d BFS time=%.3fs\n",n,Elapsed(begin));
+    begin = clock();
+    E.bfsCount = 0;
+    int rounds = Eccentricities(&E,e2);
+    printf("Bounding %d rounds of 64-source BFS time=%.3fs %s\n",rounds,Elapsed(begin),
+           memcmp(e1,e2,sizeof(int) * n) == 0 ? "OK" : "DIFFERENT");
+    Report("Network",e2,n);
+    E.bfsCount = 0;
+    int d = Diameter(&E);
+    printf("iFUB diameter %d with %lld BFS\n",d,E.bfsCount);
+    free(e1);
+    free(e2);
+    FreeEngine(&E);
+    FreeCSR(&G);
+
+    //百万顶点
+    printf("\n*******\n");
+    n = 1000000;
+    RandomNetwork(&G,n,n / 5);
+    InitEngine(&E,&G);
+    begin = clock();
+    E.bfsCount = 0;
+    d = Diameter(&E);
+    printf("Network n=%d m=%d diameter %d BFS %lld time=%.3fs\n",n,G.numEdges / 2,d,E.bfsCount,Elapsed(begin));
+    FreeEngine(&E);
+    FreeCSR(&G);
+
+    n = 30000;
+    RandomNetwork(&G,n,n / 5);
+    InitEngine(&E,&G);
+    e1 = (int*)malloc(sizeof(int) * n);
+    begin = clock();
+    rounds = Eccentricities(&E,e1);
+    printf("Network n=%d all eccentricities: %d rounds time=%.3fs\n",n,rounds,Elapsed(begin));
+    Report("Network",e1,n);
+    free(e1);
+    FreeEngine(&E);
+    FreeCSR(&G);
+
+    GridGraph(&G,1000,1000);
+    InitEngine(&E,&G);
+    begin = clock();
+    E.bfsCount = 0;
+    d = Diameter(&E);
+    printf("Grid 1000x1000 diameter %d BFS %lld time=%.3fs\n",d,E.bfsCount,Elapsed(begin));
+    FreeEngine(&E);
+    FreeCSR(&G);
+    return 0;
+}
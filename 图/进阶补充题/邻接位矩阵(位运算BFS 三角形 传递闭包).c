@@ -0,0 +1,340 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+/*
+邻接位矩阵：无权图每条边只占1位
+图-邻接矩阵.c的arc每格一个int，100个顶点就要40KB，32768个顶点要4GB；位矩阵只要1/32
+第i行为一串64位字，第j位为1表示有边i->j，整行一起做与/或/计数：
+1 BFS：下一层 = 当前层各顶点行的或 再去掉已访问；当前层很大时改为自底向上，
+  未访问顶点v的行与当前层相与不为0即被访问(无向图)
+2 公共邻居数 = popcount(第u行 & 第v行)
+3 三角形数：对每条边u-v(u<v)数 第u行 & 第v行 中编号大于v的位
+4 传递闭包(Warshall)：若i能到k，则第i行 |= 第k行，O(n^3/64)
+编译时加-mavx2则行或用256位指令一次处理4个字
+*/
+#define OK 1
+#define ERROR 0
+#define MAXVEX 100
+#define INFINITY 65535
+
+typedef int Status;
+typedef int VertexType;
+typedef int EdgeType;
+typedef unsigned long long u64;
+
+//与图-邻接矩阵.c相同
+typedef struct {
+	VertexType vexs[MAXVEX];
+	EdgeType arc[MAXVEX][MAXVEX];
+	int numNodes, numEdges;
+} MGraph;
+
+typedef struct {
+    int numNodes;
+    int words; // 每行字数，取4的倍数方便AVX2
+    u64 *bits; // numNodes * words
+} BitGraph;
+
+int Popcount(u64 x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+int Ctz(u64 x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while(!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+Status InitBitGraph(BitGraph *G,int numNodes) {
+    G->numNodes = numNodes;
+    G->words = ((numNodes + 63) / 64 + 3) & ~3;
+    G->bits = (u64*)calloc((size_t)numNodes * G->words + 1,sizeof(u64));
+    return G->bits ? OK : ERROR;
+}
+
+void FreeBitGraph(BitGraph *G) {
+    free(G->bits);
+    G->bits = NULL;
+    G->numNodes = G->words = 0;
+}
+
+u64* Row(const BitGraph *G,int i) {
+    return G->bits + (size_t)i * G->words;
+}
+
+int TestBit(const u64 *row,int j) {
+    return (row[j >> 6] >> (j & 63)) & 1;
+}
+
+void SetBit(u64 *row,int j) {
+    row[j >> 6] |= 1ULL << (j & 63);
+}
+
+void AddEdgeBit(BitGraph *G,int i,int j,int isWuxiang) {
+    SetBit(Row(G,i),j);
+    if(isWuxiang) SetBit(Row(G,j),i);
+}
+
+int HasEdgeBit(const BitGraph *G,int i,int j) {
+    return TestBit(Row(G,i),j);
+}
+//由邻接矩阵转换，arc为0或INFINITY视为无边
+Status MGraphToBit(const MGraph *M,BitGraph *G) {
+    if(!InitBitGraph(G,M->numNodes)) return ERROR;
+    for(int i = 0;i < M->numNodes;i++) {
+        for(int j = 0;j < M->numNodes;j++) {
+            if(i != j && M->arc[i][j] != 0 && M->arc[i][j] != INFINITY) SetBit(Row(G,i),j);
+        }
+    }
+    return OK;
+}
+
+/* 行运算****************************************** */
+//dst |= src
+void RowOr(u64 *dst,const u64 *src,int words) {
+    int w = 0;
+#ifdef __AVX2__
+    for(;w + 4 <= words;w += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(dst + w));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(src + w));
+        _mm256_storeu_si256((__m256i*)(dst + w),_mm256_or_si256(a,b));
+    }
+#endif
+    for(;w < words;w++) dst[w] |= src[w];
+}
+//popcount(a & b)
+int RowAndCount(const u64 *a,const u64 *b,int words) {
+    int c = 0;
+    for(int w = 0;w < words;w++) c += Popcount(a[w] & b[w]);
+    return c;
+}
+
+int RowCount(const u64 *a,int words) {
+    int c = 0;
+    for(int w = 0;w < words;w++) c += Popcount(a[w]);
+    return c;
+}
+
+int RowAny(const u64 *a,const u64 *b,int words) {
+    for(int w = 0;w < words;w++) {
+        if(a[w] & b[w]) return 1;
+    }
+    return 0;
+}
+
+int CommonNeighbors(const BitGraph *G,int u,int v) {
+    return RowAndCount(Row(G,u),Row(G,v),G->words);
+}
+
+/* BFS ********************************************* */
+//dist[v]为v到start的层数，不可达为-1，返回访问的顶点数
+//自底向上要求无向图；isWuxiang为0时只用自顶向下
+int BitBFS(const BitGraph *G,int start,int isWuxiang,int *dist) {
+    int words = G->words,n = G->numNodes;
+    u64 *visited = (u64*)calloc(words * 3,sizeof(u64));
+    u64 *frontier = visited + words,*next = frontier + words;
+    for(int v = 0;v < n;v++) dist[v] = -1;
+    SetBit(visited,start);
+    SetBit(frontier,start);
+    dist[start] = 0;
+    int count = 1,frontierSize = 1,level = 0;
+    while(frontierSize) {
+        level++;
+        memset(next,0,sizeof(u64) * words);
+        if(isWuxiang && frontierSize * 16 > n - count) {
+            //自底向上：当前层比剩下的顶点还多时，让每个未访问顶点看自己的行
+            for(int v = 0;v < n;v++) {
+                if(!TestBit(visited,v) && RowAny(Row(G,v),frontier,words)) SetBit(next,v);
+            }
+        } else {
+            //自顶向下：当前层各行或起来
+            for(int w = 0;w < words;w++) {
+                for(u64 x = frontier[w];x;x &= x - 1) RowOr(next,Row(G,w * 64 + Ctz(x)),words);
+            }
+            for(int w = 0;w < words;w++) next[w] &= ~visited[w];
+        }
+        frontierSize = 0;
+        for(int w = 0;w < words;w++) {
+            for(u64 x = next[w];x;x &= x - 1) dist[w * 64 + Ctz(x)] = level;
+            frontierSize += Popcount(next[w]);
+            visited[w] |= next[w];
+        }
+        count += frontierSize;
+        u64 *t = frontier;
+        frontier = next;
+        next = t;
+    }
+    free(visited);
+    return count;
+}
+
+/* 三角形 ******************************************* */
+//无向图三角形个数，每个三角形u<v<w只数一次
+long long CountTriangles(const BitGraph *G) {
+    long long total = 0;
+    int words = G->words;
+    for(int u = 0;u < G->numNodes;u++) {
+        const u64 *ru = Row(G,u);
+        for(int wu = (u + 1) >> 6;wu < words;wu++) {
+            u64 x = ru[wu];
+            if(wu == (u + 1) >> 6) x &= ~0ULL << ((u + 1) & 63);
+            for(;x;x &= x - 1) {
+                int v = wu * 64 + Ctz(x);
+                const u64 *rv = Row(G,v);
+                //只数编号大于v的公共邻居
+                int first = (v + 1) >> 6;
+                if(first >= words) continue;
+                total += Popcount(ru[first] & rv[first] & (~0ULL << ((v + 1) & 63)));
+                for(int w = first + 1;w < words;w++) total += Popcount(ru[w] & rv[w]);
+            }
+        }
+    }
+    return total;
+}
+
+/* 传递闭包 ***************************************** */
+//Warshall：C[i][j] = 1 表示i能到j(走至少一条边)
+Status TransitiveClosure(const BitGraph *G,BitGraph *C) {
+    if(!InitBitGraph(C,G->numNodes)) return ERROR;
+    memcpy(C->bits,G->bits,sizeof(u64) * G->numNodes * G->words);
+    for(int k = 0;k < C->numNodes;k++) {
+        const u64 *rk = Row(C,k);
+        for(int i = 0;i < C->numNodes;i++) {
+            if(TestBit(Row(C,i),k)) RowOr(Row(C,i),rk,C->words);
+        }
+    }
+    return OK;
+}
+
+/* 对照：int矩阵的做法 ****************************** */
+void ClosureInt(int *A,int n) {
+    for(int k = 0;k < n;k++) {
+        for(int i = 0;i < n;i++) {
+            if(!A[i * n + k]) continue;
+            for(int j = 0;j < n;j++) {
+                if(A[k * n + j]) A[i * n + j] = 1;
+            }
+        }
+    }
+}
+
+long long TrianglesInt(const int *A,int n) {
+    long long total = 0;
+    for(int u = 0;u < n;u++) {
+        for(int v = u + 1;v < n;v++) {
+            if(!A[u * n + v]) continue;
+            for(int w = v + 1;w < n;w++) total += A[u * n + w] && A[v * n + w];
+        }
+    }
+    return total;
+}
+
+double Elapsed(clock_t begin) {
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+//随机图，边的概率为 permille/1000
+void RandomGraph(BitGraph *G,int *A,int n,int permille,int isWuxiang) {
+    InitBitGraph(G,n);
+    memset(A,0,sizeof(int) * n * n);
+    for(int i = 0;i < n;i++) {
+        for(int j = isWuxiang ? i + 1 : 0;j < n;j++) {
+            if(i == j || rand() % 1000 >= permille) continue;
+            AddEdgeBit(G,i,j,isWuxiang);
+            A[i * n + j] = 1;
+            if(isWuxiang) A[j * n + i] = 1;
+        }
+    }
+}
+
+int main() {
+    //小例子：与图-邻接矩阵.c相同的MGraph
+    MGraph M;
+    M.numNodes = 6;
+    M.numEdges = 7;
+    for(int i = 0;i < M.numNodes;i++) {
+        M.vexs[i] = i + 1;
+        for(int j = 0;j < M.numNodes;j++) M.arc[i][j] = i == j ? 0 : INFINITY;
+    }
+    int edge[7][2] = {{1,2},{1,3},{2,3},{2,4},{3,4},{4,5},{5,6}};
+    for(int i = 0;i < 7;i++) {
+        M.arc[edge[i][0] - 1][edge[i][1] - 1] = 1;
+        M.arc[edge[i][1] - 1][edge[i][0] - 1] = 1;
+    }
+    BitGraph G,C;
+    MGraphToBit(&M,&G);
+    int dist[6];
+    BitBFS(&G,0,1,dist);
+    printf("BFS from 1:");
+    for(int i = 0;i < 6;i++) printf(" %d:%d",i + 1,dist[i]);
+    printf("\nTriangles %lld, common neighbors of 2 and 3: %d\n",CountTriangles(&G),CommonNeighbors(&G,1,2));
+    printf("MGraph %zu bytes, BitGraph %zu bytes\n",sizeof(MGraph),sizeof(u64) * G.numNodes * G.words);
+    FreeBitGraph(&G);
+
+    //无向随机图：三角形与BFS
+    printf("\n*******\n");
+    srand(2024);
+    int n = 2000;
+    int *A = (int*)malloc(sizeof(int) * n * n);
+    RandomGraph(&G,A,n,50,1);
+    clock_t begin = clock();
+    long long t1 = CountTriangles(&G);
+    double tb = Elapsed(begin);
+    begin = clock();
+    long long t2 = TrianglesInt(A,n);
+    printf("n=%d triangles bit %lld (%.3fs) int %lld (%.3fs)\n",n,t1,tb,t2,Elapsed(begin));
+    int *d = (int*)malloc(sizeof(int) * n);
+    begin = clock();
+    int reached = 0;
+    for(int s = 0;s < 100;s++) reached += BitBFS(&G,s,1,d);
+    printf("100 BFS reached %d time=%.3fs, eccentricity of 1 = ",reached,Elapsed(begin));
+    BitBFS(&G,0,1,d);
+    int ecc = 0;
+    for(int v = 0;v < n;v++) if(d[v] > ecc) ecc = d[v];
+    printf("%d\n",ecc);
+    FreeBitGraph(&G);
+
+    //有向稀疏图：传递闭包
+    printf("\n*******\n");
+    n = 1000;
+    RandomGraph(&G,A,n,2,0);
+    begin = clock();
+    TransitiveClosure(&G,&C);
+    tb = Elapsed(begin);
+    begin = clock();
+    ClosureInt(A,n);
+    double ti = Elapsed(begin);
+    int same = 1;
+    long long pairs = 0;
+    for(int i = 0;i < n;i++) {
+        for(int j = 0;j < n;j++) {
+            if(HasEdgeBit(&C,i,j) != A[i * n + j]) same = 0;
+            pairs += A[i * n + j];
+        }
+    }
+    printf("n=%d closure pairs %lld bit %.3fs int %.3fs %s\n",n,pairs,tb,ti,same ? "OK" : "DIFFERENT");
+    printf("int matrix %zu bytes, bit matrix %zu bytes\n",sizeof(int) * n * n,sizeof(u64) * C.numNodes * C.words);
+    FreeBitGraph(&G);
+    FreeBitGraph(&C);
+    free(A);
+    free(d);
+    return 0;
+}
@@ -24,6 +24,7 @@
  /* 思路 
 构建有向图，若a/b=value，构建边：a-value->b，b-value的倒数->a
 若求a->c，则从a进行DFS，并累乘边的value，直到到达c，无法到达则未-1
+带权并查集+哈希表版本见 除法问题(带权并查集).c
  */ 
 #define MAX 100
 typedef struct EdgeNode {
@@ -0,0 +1,243 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*
+除法问题-带权并查集
+除法问题(DFS).c每个问题都从头DFS一遍，变量名用strcmp线性查找，10^5个等式和问题时太慢
+1 变量名驻留(interning)：开放定址哈希表把字符串映射为编号，名字统一存在一块连续内存里
+2 带权并查集：parent[x]为x的父结点，weight[x] = x / parent[x]
+  Find时路径压缩，同时把weight改为 x / 根
+  a / b = v 合并：ra、rb为根，wa = a/ra，wb = b/rb，则 ra / rb = v * wb / wa
+  问题 a / b：同根时答案为 wa / wb，不同根或变量不存在为-1
+每次操作近似O(1)，等式可以和问题交替到来(流式)
+*/
+typedef struct {
+    //哈希表：slot存编号+1，0为空
+    int *slot;
+    unsigned int mask;
+    //名字：第i个名字为names[nameOffset[i]]开始的'\0'结尾字符串
+    char *names;
+    long long namesSize,namesCapacity;
+    long long *nameOffset;
+    unsigned int *hash;
+    //并查集
+    int *parent,*size;
+    double *weight;
+    int count,capacity;
+} Equations;
+
+unsigned int HashString(const char *s) {
+    //FNV-1a
+    unsigned int h = 2166136261u;
+    while(*s) {
+        h ^= (unsigned char)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+int InitEquations(Equations *E,int capacity) {
+    if(capacity < 16) capacity = 16;
+    unsigned int t = 16;
+    while(t < (unsigned int)capacity * 2) t <<= 1;
+    E->slot = (int*)calloc(t,sizeof(int));
+    E->mask = t - 1;
+    E->namesCapacity = (long long)capacity * 8;
+    E->namesSize = 0;
+    E->names = (char*)malloc(E->namesCapacity);
+    E->nameOffset = (long long*)malloc(sizeof(long long) * capacity);
+    E->hash = (unsigned int*)malloc(sizeof(unsigned int) * capacity);
+    E->parent = (int*)malloc(sizeof(int) * capacity);
+    E->size = (int*)malloc(sizeof(int) * capacity);
+    E->weight = (double*)malloc(sizeof(double) * capacity);
+    E->count = 0;
+    E->capacity = capacity;
+    return E->slot && E->names && E->nameOffset && E->hash && E->parent && E->size && E->weight;
+}
+
+void DestroyEquations(Equations *E) {
+    free(E->slot); free(E->names); free(E->nameOffset); free(E->hash);
+    free(E->parent); free(E->size); free(E->weight);
+}
+//查找变量名编号，不存在返回-1
+int FindName(const Equations *E,const char *name) {
+    unsigned int h = HashString(name);
+    unsigned int i = h & E->mask;
+    while(E->slot[i]) {
+        int k = E->slot[i] - 1;
+        if(E->hash[k] == h && strcmp(E->names + E->nameOffset[k],name) == 0) return k;
+        i = (i + 1) & E->mask;
+    }
+    return -1;
+}
+//扩容：数组翻倍，哈希表用保存的hash值重新散列
+int GrowEquations(Equations *E) {
+    int capacity = E->capacity * 2;
+    long long *nameOffset = (long long*)realloc(E->nameOffset,sizeof(long long) * capacity);
+    if(nameOffset) E->nameOffset = nameOffset;
+    unsigned int *hash = (unsigned int*)realloc(E->hash,sizeof(unsigned int) * capacity);
+    if(hash) E->hash = hash;
+    int *parent = (int*)realloc(E->parent,sizeof(int) * capacity);
+    if(parent) E->parent = parent;
+    int *size = (int*)realloc(E->size,sizeof(int) * capacity);
+    if(size) E->size = size;
+    double *weight = (double*)realloc(E->weight,sizeof(double) * capacity);
+    if(weight) E->weight = weight;
+    unsigned int t = (E->mask + 1) * 2;
+    int *slot = (int*)calloc(t,sizeof(int));
+    if(!nameOffset || !hash || !parent || !size || !weight || !slot) {
+        free(slot);
+        return 0;
+    }
+    free(E->slot);
+    E->slot = slot;
+    E->mask = t - 1;
+    E->capacity = capacity;
+    for(int k = 0;k < E->count;k++) {
+        unsigned int i = E->hash[k] & E->mask;
+        while(E->slot[i]) i = (i + 1) & E->mask;
+        E->slot[i] = k + 1;
+    }
+    return 1;
+}
+// 查找节点名是否已经存在，存在返回索引，不存在就新增
+int GetNodeIndex(Equations *E,const char *name) {
+    int k = FindName(E,name);
+    if(k != -1) return k;
+    if(E->count == E->capacity && !GrowEquations(E)) return -1;
+    long long len = (long long)strlen(name) + 1;
+    if(E->namesSize + len > E->namesCapacity) {
+        long long capacity = E->namesCapacity * 2;
+        while(E->namesSize + len > capacity) capacity *= 2;
+        char *names = (char*)realloc(E->names,capacity);
+        if(!names) return -1;
+        E->names = names;
+        E->namesCapacity = capacity;
+    }
+    k = E->count++;
+    memcpy(E->names + E->namesSize,name,len);
+    E->nameOffset[k] = E->namesSize;
+    E->namesSize += len;
+    E->hash[k] = HashString(name);
+    unsigned int i = E->hash[k] & E->mask;
+    while(E->slot[i]) i = (i + 1) & E->mask;
+    E->slot[i] = k + 1;
+    //新变量自成一个集合
+    E->parent[k] = k;
+    E->size[k] = 1;
+    E->weight[k] = 1.0;
+    return k;
+}
+//找根，返回x / 根存入*w，路径压缩(非递归两遍)
+int Find(Equations *E,int x,double *w) {
+    int root = x;
+    double total = 1.0;
+    while(E->parent[root] != root) {
+        total *= E->weight[root];
+        root = E->parent[root];
+    }
+    //第二遍：路径上每个点直接指向根，weight改为该点 / 根
+    double cur = total;
+    while(E->parent[x] != x) {
+        int next = E->parent[x];
+        double wx = E->weight[x];
+        E->parent[x] = root;
+        E->weight[x] = cur;
+        cur /= wx;
+        x = next;
+    }
+    *w = total;
+    return root;
+}
+//加入等式 a / b = value
+int AddEquation(Equations *E,const char *a,const char *b,double value) {
+    int ia = GetNodeIndex(E,a),ib = GetNodeIndex(E,b);
+    if(ia == -1 || ib == -1) return 0;
+    double wa,wb;
+    int ra = Find(E,ia,&wa),rb = Find(E,ib,&wb);
+    if(ra == rb) return 1; // 题目保证没有矛盾
+    //按大小合并，小的挂到大的下面
+    if(E->size[ra] <= E->size[rb]) {
+        E->parent[ra] = rb;
+        E->weight[ra] = value * wb / wa;
+        E->size[rb] += E->size[ra];
+    } else {
+        E->parent[rb] = ra;
+        E->weight[rb] = wa / (value * wb);
+        E->size[ra] += E->size[rb];
+    }
+    return 1;
+}
+//问题 a / b，无法确定返回-1.0
+double Query(Equations *E,const char *a,const char *b) {
+    int ia = FindName(E,a),ib = FindName(E,b);
+    if(ia == -1 || ib == -1) return -1.0;
+    double wa,wb;
+    if(Find(E,ia,&wa) != Find(E,ib,&wb)) return -1.0;
+    return wa / wb;
+}
+//与除法问题(DFS).c相同的接口
+double* calcEquation(char*** equations, int equationsSize, int* equationsColSize, double* values, int valuesSize, char*** queries, int queriesSize, int* queriesColSize, int* returnSize) {
+    (void)equationsColSize; (void)valuesSize; (void)queriesColSize;
+    Equations E;
+    InitEquations(&E,equationsSize * 2);
+    for(int i = 0;i < equationsSize;i++) {
+        AddEquation(&E,equations[i][0],equations[i][1],values[i]);
+    }
+    *returnSize = queriesSize;
+    double* result = (double*)malloc(sizeof(double) * queriesSize);
+    for(int i = 0;i < queriesSize;i++) {
+        result[i] = Query(&E,queries[i][0],queries[i][1]);
+    }
+    DestroyEquations(&E);
+    return result;
+}
+
+int main() {
+    //equations = [["a","b"],["b","c"]], values = [2.0,3.0], queries = [["a","c"],["b","a"],["a","e"],["a","a"],["x","x"]]
+    char *e0[] = {"a","b"},*e1[] = {"b","c"};
+    char **equations[] = {e0,e1};
+    double values[] = {2.0,3.0};
+    char *q0[] = {"a","c"},*q1[] = {"b","a"},*q2[] = {"a","e"},*q3[] = {"a","a"},*q4[] = {"x","x"};
+    char **queries[] = {q0,q1,q2,q3,q4};
+    int colSize[] = {2,2,2,2,2},returnSize;
+    double *result = calcEquation(equations,2,colSize,values,2,queries,5,colSize,&returnSize);
+    printf("[");
+    for(int i = 0;i < returnSize;i++) printf(i ? ",%.5f" : "%.5f",result[i]);
+    printf("]\n");
+    free(result);
+
+    //流式：10^5个等式与10^5个问题交替到来
+    printf("\n*******\n");
+    int n = 100000;
+    Equations E;
+    InitEquations(&E,16);
+    //变量v_i的真实值为 i+1，等式随机连两个变量
+    double *truth = (double*)malloc(sizeof(double) * n);
+    for(int i = 0;i < n;i++) truth[i] = i + 1;
+    srand(2024);
+    char a[32],b[32];
+    int answered = 0,wrong = 0;
+    clock_t begin = clock();
+    for(int i = 0;i < n;i++) {
+        int x = rand() % n,y = rand() % n;
+        sprintf(a,"v_%d",x);
+        sprintf(b,"v_%d",y);
+        AddEquation(&E,a,b,truth[x] / truth[y]);
+        x = rand() % n;
+        y = rand() % n;
+        sprintf(a,"v_%d",x);
+        sprintf(b,"v_%d",y);
+        double r = Query(&E,a,b);
+        if(r != -1.0) {
+            answered++;
+            double expect = truth[x] / truth[y];
+            if(r / expect > 1 + 1e-9 || r / expect < 1 - 1e-9) wrong++;
+        }
+    }
+    printf("Equations %d queries %d answered %d wrong %d variables %d time=%.3fs\n",n,n,answered,wrong,E.count,(double)(clock() - begin) / CLOCKS_PER_SEC);
+    free(truth);
+    DestroyEquations(&E);
+    return 0;
+}
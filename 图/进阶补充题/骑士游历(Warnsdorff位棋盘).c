@@ -0,0 +1,283 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+/*
+骑士游历：Warnsdorff启发 + 位棋盘 + 非递归回溯
+骑士游历问题(DFS).c固定N为8，八个方向不排序地递归尝试，走不通也不撤销cal，棋盘稍大就跑不完
+1 位棋盘：已访问的格子存为位集合，N<=8时一个64位整数即可，
+  一格的可走数 = popcount(该格骑士攻击位 & ~已访问)；N>8时用多个64位字，可走格查预先算好的邻接表
+2 Warnsdorff规则：总是先走"下一步可走数最少"的格子，可走数相同时先走离中心远的格子
+  按这个顺序几乎不需要回溯，100x100也只要几毫秒
+3 非递归回溯：每一步保存排好序的候选格和当前试到第几个，走不通时撤销该步(清除访问位)再试下一个
+4 闭合游历：最后一格必须能一步跳回起点；Enumerate可枚举所有(limit<=0)或前limit条游历
+*/
+typedef unsigned long long u64;
+
+typedef struct {
+    int n,size,words;
+    u64 *visited; // 已访问位集合，第sq位为1表示已访问
+    u64 *attack; // N<=8时每格的骑士攻击位
+    int *nb; // 每格最多8个可跳到的格子 nb[sq*8+k]
+    unsigned char *nbCount;
+    int *path; // path[i]为第i步所在格子
+    int *cand; // 每一步的候选格，cand[step*8+k]
+    unsigned char *candCount,*candIndex;
+    int closed,start; // 是否要求闭合，起点
+    long long nodes; // 尝试的步数
+} Board;
+
+int dx[] = {2,1,-1,-2,-2,-1,1,2};
+int dy[] = {1,2,2,1,-1,-2,-2,-1};
+
+int Popcount(u64 x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    int c = 0;
+    while(x) {
+        x &= x - 1;
+        c++;
+    }
+    return c;
+#endif
+}
+
+int IsVisited(const Board *B,int sq) {
+    return (B->visited[sq >> 6] >> (sq & 63)) & 1;
+}
+
+void Visit(Board *B,int sq) {
+    B->visited[sq >> 6] |= 1ULL << (sq & 63);
+}
+
+void Unvisit(Board *B,int sq) {
+    B->visited[sq >> 6] &= ~(1ULL << (sq & 63));
+}
+//可走数
+int Degree(const Board *B,int sq) {
+    if(B->attack) return Popcount(B->attack[sq] & ~B->visited[0]);
+    int d = 0;
+    for(int k = 0;k < B->nbCount[sq];k++) {
+        if(!IsVisited(B,B->nb[sq * 8 + k])) d++;
+    }
+    return d;
+}
+
+int InitBoard(Board *B,int n) {
+    B->n = n;
+    B->size = n * n;
+    B->words = (B->size + 63) / 64;
+    B->visited = (u64*)calloc(B->words,sizeof(u64));
+    B->attack = n <= 8 ? (u64*)calloc(B->size,sizeof(u64)) : NULL;
+    B->nb = (int*)malloc(sizeof(int) * B->size * 8);
+    B->nbCount = (unsigned char*)malloc(B->size);
+    B->path = (int*)malloc(sizeof(int) * B->size);
+    B->cand = (int*)malloc(sizeof(int) * B->size * 8);
+    B->candCount = (unsigned char*)malloc(B->size);
+    B->candIndex = (unsigned char*)malloc(B->size);
+    if(!B->visited || (n <= 8 && !B->attack) || !B->nb || !B->nbCount || !B->path ||
+       !B->cand || !B->candCount || !B->candIndex) return 0;
+    for(int x = 0;x < n;x++) {
+        for(int y = 0;y < n;y++) {
+            int sq = x * n + y,count = 0;
+            for(int k = 0;k < 8;k++) {
+                int nx = x + dx[k],ny = y + dy[k];
+                //判断是否越界
+                if(nx < 0 || nx >= n || ny < 0 || ny >= n) continue;
+                B->nb[sq * 8 + count++] = nx * n + ny;
+                if(B->attack) B->attack[sq] |= 1ULL << (nx * n + ny);
+            }
+            B->nbCount[sq] = (unsigned char)count;
+        }
+    }
+    return 1;
+}
+
+void FreeBoard(Board *B) {
+    free(B->visited); free(B->attack); free(B->nb); free(B->nbCount);
+    free(B->path); free(B->cand); free(B->candCount); free(B->candIndex);
+}
+
+void ClearBoard(Board *B) {
+    for(int i = 0;i < B->words;i++) B->visited[i] = 0;
+    B->nodes = 0;
+}
+//离中心的距离(放大为整数)
+int CenterDist(const Board *B,int sq) {
+    int x = 2 * (sq / B->n) - (B->n - 1),y = 2 * (sq % B->n) - (B->n - 1);
+    return x * x + y * y;
+}
+//离起点的距离
+int StartDist(const Board *B,int sq) {
+    int x = sq / B->n - B->start / B->n,y = sq % B->n - B->start % B->n;
+    return x * x + y * y;
+}
+//生成第step步的候选格，按(可走数升序，离中心距离降序)排序
+//闭合游历时第二关键字改为离起点距离降序，起点附近留到最后走，才能跳回起点
+void GenCandidates(Board *B,int step) {
+    int sq = B->path[step];
+    int *c = B->cand + step * 8;
+    long long key[8]; // 高32位可走数，低位减去距离，大棋盘上距离也不会进位到可走数
+    int count = 0;
+    int last = step + 2 == B->size; // 下一步就是最后一格
+    for(int k = 0;k < B->nbCount[sq];k++) {
+        int next = B->nb[sq * 8 + k];
+        if(IsVisited(B,next)) continue;
+        int d = Degree(B,next);
+        //可走数为0的格子只能作为最后一格
+        if(d == 0 && !last) continue;
+        c[count] = next;
+        key[count] = ((long long)d << 32) - (B->closed ? StartDist(B,next) : CenterDist(B,next));
+        count++;
+    }
+    //插入排序(最多8个)
+    for(int i = 1;i < count;i++) {
+        long long ck = key[i];
+        int cv = c[i],j = i - 1;
+        while(j >= 0 && key[j] > ck) {
+            key[j + 1] = key[j];
+            c[j + 1] = c[j];
+            j--;
+        }
+        key[j + 1] = ck;
+        c[j + 1] = cv;
+    }
+    B->candCount[step] = (unsigned char)count;
+    B->candIndex[step] = 0;
+}
+
+int IsNeighbor(const Board *B,int a,int b) {
+    for(int k = 0;k < B->nbCount[a];k++) {
+        if(B->nb[a * 8 + k] == b) return 1;
+    }
+    return 0;
+}
+
+typedef void (*TourVisit)(const Board *B,void *ctx);
+
+//非递归回溯，找到的游历交给visit，返回找到的条数
+//limit为最多找几条，budget为最多尝试的步数，两者<=0都表示不限
+long long Enumerate(Board *B,int start,int closed,long long limit,long long budget,TourVisit visit,void *ctx) {
+    ClearBoard(B);
+    B->start = start;
+    B->closed = closed;
+    long long found = 0;
+    int step = 0;
+    B->path[0] = start;
+    Visit(B,start);
+    if(B->size == 1) {
+        if(visit) visit(B,ctx);
+        return 1;
+    }
+    GenCandidates(B,0);
+    while(step >= 0) {
+        if(budget > 0 && B->nodes >= budget) break;
+        if(B->candIndex[step] < B->candCount[step]) {
+            int next = B->cand[step * 8 + B->candIndex[step]++];
+            B->nodes++;
+            step++;
+            B->path[step] = next;
+            Visit(B,next);
+            if(step == B->size - 1) {
+                //走完所有格子
+                if(!closed || IsNeighbor(B,next,start)) {
+                    found++;
+                    if(visit) visit(B,ctx);
+                    if(limit > 0 && found >= limit) break;
+                }
+                Unvisit(B,next);
+                step--;
+            } else if(closed && Degree(B,start) == 0) {
+                //起点周围都走过了，最后一格不可能跳回起点
+                Unvisit(B,next);
+                step--;
+            } else {
+                GenCandidates(B,step);
+            }
+        } else {
+            //候选格都试过了，撤销这一步
+            Unvisit(B,B->path[step]);
+            step--;
+        }
+    }
+    return found;
+}
+//找一条游历
+int Solve(Board *B,int start,int closed,long long budget) {
+    return Enumerate(B,start,closed,1,budget,NULL,NULL) == 1;
+}
+
+//检查path是否为合法游历
+int CheckTour(const Board *B,int closed) {
+    char *seen = (char*)calloc(B->size,1);
+    int ok = 1;
+    for(int i = 0;i < B->size && ok;i++) {
+        if(seen[B->path[i]]) ok = 0;
+        seen[B->path[i]] = 1;
+        if(i > 0 && !IsNeighbor(B,B->path[i - 1],B->path[i])) ok = 0;
+    }
+    if(closed && !IsNeighbor(B,B->path[B->size - 1],B->path[0])) ok = 0;
+    free(seen);
+    return ok;
+}
+//打印棋盘(数字顺序升序则为骑士游历路线)
+void PrintChress(const Board *B) {
+    int *order = (int*)malloc(sizeof(int) * B->size);
+    for(int i = 0;i < B->size;i++) order[B->path[i]] = i + 1;
+    for(int i = 0;i < B->n;i++) {
+        for(int j = 0;j < B->n;j++) printf("%3d ",order[i * B->n + j]);
+        printf("\n");
+    }
+    free(order);
+}
+
+void CountTour(const Board *B,void *ctx) {
+    (void)B;
+    (*(long long*)ctx)++;
+}
+
+int main() {
+    Board B;
+    InitBoard(&B,8);
+    int x = 0,y = 0;
+    Solve(&B,x * B.n + y,0,0);
+    printf("8x8 open tour from (%d,%d), tries %lld\n",x,y,B.nodes);
+    PrintChress(&B);
+    Solve(&B,x * B.n + y,1,0);
+    printf("8x8 closed tour from (%d,%d) %s, tries %lld\n",x,y,CheckTour(&B,1) ? "OK" : "ERROR",B.nodes);
+    PrintChress(&B);
+    FreeBoard(&B);
+
+    //枚举闭合游历
+    printf("\n*******\n");
+    InitBoard(&B,6);
+    long long count = 0;
+    clock_t begin = clock();
+    Enumerate(&B,0,1,1000,0,CountTour,&count);
+    printf("6x6 first %lld closed tours from corner, tries %lld time=%.3fs\n",count,B.nodes,(double)(clock() - begin) / CLOCKS_PER_SEC);
+    FreeBoard(&B);
+    //limit为0：枚举全部
+    InitBoard(&B,5);
+    count = 0;
+    begin = clock();
+    Enumerate(&B,0,0,0,0,CountTour,&count);
+    printf("5x5 all %lld open tours from corner, tries %lld time=%.3fs\n",count,B.nodes,(double)(clock() - begin) / CLOCKS_PER_SEC);
+    FreeBoard(&B);
+
+    //大棋盘
+    printf("\n*******\n");
+    int sizes[] = {8,20,50,100,200};
+    for(int i = 0;i < 5;i++) {
+        InitBoard(&B,sizes[i]);
+        begin = clock();
+        int ok = Solve(&B,0,0,(long long)B.size * 10);
+        printf("%dx%d open   %s tries %lld time=%.3fms\n",B.n,B.n,ok && CheckTour(&B,0) ? "OK" : "FAIL",
+               B.nodes,1000.0 * (clock() - begin) / CLOCKS_PER_SEC);
+        begin = clock();
+        ok = Solve(&B,0,1,(long long)B.size * 10);
+        printf("%dx%d closed %s tries %lld time=%.3fms\n",B.n,B.n,ok && CheckTour(&B,1) ? "OK" : "FAIL",
+               B.nodes,1000.0 * (clock() - begin) / CLOCKS_PER_SEC);
+        FreeBoard(&B);
+    }
+    return 0;
+}
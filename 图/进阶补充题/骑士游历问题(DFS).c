@@ -2,6 +2,7 @@
 #include <stdbool.h>
 /*
 骑士游历问题：在国际棋盘上使一个骑士遍历所有的格子一遍且仅一遍，对于任意给定的顶点，输出一条符合上述要求的路径。
+大棋盘、闭合游历见 骑士游历(Warnsdorff位棋盘).c
 */
 #define N 8
 //用于记录顺序，访问则+1
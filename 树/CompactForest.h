@@ -0,0 +1,332 @@
+#ifndef COMPACT_FOREST_H
+#define COMPACT_FOREST_H
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+/*
+紧凑森林：一般树/森林的数组存储
+结点按层序编号(各棵树的根为0..numRoots-1)，同一结点的孩子编号连续，
+所以孩子表只需要起点：childStart[v] ~ childStart[v+1]-1 为v的孩子，相当于adj[e]=e的CSR
+parent[v]为双亲，根为-1；data[v]为结点数据
+LOUDS：按层序把每个结点的度写成d个1加一个0，前面再加一个虚根(numRoots个1加0)，共2n+1位
+  第k个1(从0数)对应结点k，结点x的描述从第x+1个0之后开始：
+  第一个孩子 = x描述起点之前1的个数，双亲 = 结点x对应的那个1之前0的个数-1
+  加上每512位一个的累计1个数(rank目录)，rank为O(1)，select在目录上二分
+  只用LOUDS时每个结点约2.1位，代替childStart的32位
+二进制文件：文件头后各数组按64字节对齐依次存放，加载时mmap整个文件，数组直接指向映射内存，
+不用逐个结点读入和建树；文件内容不可信，映射后顺序校验一遍各数组，O(n)
+*/
+#define FOREST_ALIGN 64
+
+typedef struct {
+    int numNodes,numRoots;
+    int *parent; // numNodes 个
+    int *childStart; // numNodes+1 个
+    char *data; // numNodes 个
+    unsigned long long *louds; // loudsBits 位
+    unsigned *loudsRank; // 每512位之前1的个数，最后多一个为总数
+    long long loudsBits;
+    void *mapping; // 由MapCompactForest映射时非NULL
+    size_t mappingSize;
+} CompactForest;
+
+void InitCompactForest(CompactForest *F) {
+    memset(F,0,sizeof(CompactForest));
+}
+
+int AllocCompactForest(CompactForest *F,int numNodes,int numRoots) {
+    InitCompactForest(F);
+    F->numNodes = numNodes;
+    F->numRoots = numRoots;
+    F->parent = (int*)malloc(sizeof(int) * (numNodes > 0 ? numNodes : 1));
+    F->childStart = (int*)malloc(sizeof(int) * (numNodes + 1));
+    F->data = (char*)malloc(numNodes > 0 ? numNodes : 1);
+    return F->parent && F->childStart && F->data;
+}
+
+void FreeCompactForest(CompactForest *F) {
+    if(F->mapping) {
+#ifndef _WIN32
+        munmap(F->mapping,F->mappingSize);
+#else
+        free(F->mapping);
+#endif
+    } else {
+        free(F->parent);
+        free(F->childStart);
+        free(F->data);
+        free(F->louds);
+        free(F->loudsRank);
+    }
+    InitCompactForest(F);
+}
+
+int Degree(const CompactForest *F,int v) {
+    return F->childStart[v + 1] - F->childStart[v];
+}
+//childStart已填好时由它推出parent
+void FillParent(CompactForest *F) {
+    for(int v = 0;v < F->numRoots;v++) F->parent[v] = -1;
+    for(int v = 0;v < F->numNodes;v++) {
+        for(int c = F->childStart[v];c < F->childStart[v + 1];c++) F->parent[c] = v;
+    }
+}
+
+/* LOUDS ******************************************** */
+long long LoudsWords(long long bits) {
+    return (bits + 63) / 64;
+}
+
+long long LoudsBlocks(long long bits) {
+    return (LoudsWords(bits) + 7) / 8;
+}
+
+void BuildLoudsRank(CompactForest *F) {
+    long long words = LoudsWords(F->loudsBits),blocks = LoudsBlocks(F->loudsBits);
+    unsigned ones = 0;
+    for(long long b = 0;b < blocks;b++) {
+        F->loudsRank[b] = ones;
+        for(long long w = b * 8;w < words && w < b * 8 + 8;w++) ones += (unsigned)__builtin_popcountll(F->louds[w]);
+    }
+    F->loudsRank[blocks] = ones;
+}
+
+int BuildLouds(CompactForest *F) {
+    F->loudsBits = 2LL * F->numNodes + 1;
+    F->louds = (unsigned long long*)calloc(LoudsWords(F->loudsBits) + 1,sizeof(unsigned long long));
+    F->loudsRank = (unsigned*)malloc(sizeof(unsigned) * (LoudsBlocks(F->loudsBits) + 1));
+    if(!F->louds || !F->loudsRank) return 0;
+    long long p = 0;
+    for(int v = -1;v < F->numNodes;v++) {
+        int d = v < 0 ? F->numRoots : Degree(F,v);
+        for(int k = 0;k < d;k++,p++) F->louds[p >> 6] |= 1ULL << (p & 63);
+        p++; // 0
+    }
+    BuildLoudsRank(F);
+    return 1;
+}
+//[0,p)中1的个数
+long long Rank1(const CompactForest *F,long long p) {
+    long long w = p >> 6,r = F->loudsRank[p >> 9];
+    for(long long k = (p >> 9) * 8;k < w;k++) r += __builtin_popcountll(F->louds[k]);
+    if(p & 63) r += __builtin_popcountll(F->louds[w] & ((1ULL << (p & 63)) - 1));
+    return r;
+}
+//第k个(从1数)1或0的位置。目录上二分找块，块内逐字数，字内逐位
+long long Select(const CompactForest *F,long long k,int bit) {
+    long long lo = 0,hi = LoudsBlocks(F->loudsBits) - 1;
+    while(lo < hi) {
+        long long mid = (lo + hi + 1) / 2;
+        long long before = bit ? F->loudsRank[mid] : mid * 512 - F->loudsRank[mid];
+        if(before < k) lo = mid;
+        else hi = mid - 1;
+    }
+    long long before = bit ? F->loudsRank[lo] : lo * 512 - F->loudsRank[lo];
+    for(long long w = lo * 8;;w++) {
+        unsigned long long x = bit ? F->louds[w] : ~F->louds[w];
+        long long c = __builtin_popcountll(x);
+        if(before + c >= k) {
+            for(long long need = k - before;need > 1;need--) x &= x - 1;
+            return w * 64 + __builtin_ctzll(x);
+        }
+        before += c;
+    }
+}
+//x的第一个孩子编号(没有孩子时为下一个结点的第一个孩子)，度
+int LoudsFirstChild(const CompactForest *F,int x,int *degree) {
+    long long start = Select(F,x + 1,0) + 1,end = Select(F,x + 2,0);
+    *degree = (int)(end - start);
+    return (int)Rank1(F,start);
+}
+
+int LoudsParent(const CompactForest *F,int x) {
+    long long q = Select(F,x + 1,1);
+    return (int)(q - Rank1(F,q)) - 1;
+}
+
+/* 遍历 ********************************************* */
+//层序编号下最后一个结点最深，高度为它的深度+1
+int ForestHeight(const CompactForest *F) {
+    int height = 0;
+    for(int v = F->numNodes - 1;v >= 0;v = F->parent[v]) height++;
+    return height;
+}
+//代替递归的LeafCount：顺序扫一遍childStart
+int ForestLeafCount(const CompactForest *F) {
+    int count = 0;
+    for(int v = 0;v < F->numNodes;v++) count += F->childStart[v + 1] == F->childStart[v];
+    return count;
+}
+
+int ForestDegree(const CompactForest *F) {
+    int maxDegree = 0;
+    for(int v = 0;v < F->numNodes;v++) {
+        if(Degree(F,v) > maxDegree) maxDegree = Degree(F,v);
+    }
+    return maxDegree;
+}
+//同GetHeadForest：先根遍历各棵树，显式栈。out为NULL时打印
+int ForestPreorder(const CompactForest *F,char *out) {
+    int *stack = (int*)malloc(sizeof(int) * (F->numNodes + 1)),top = 0,n = 0;
+    for(int r = F->numRoots - 1;r >= 0;r--) stack[top++] = r;
+    while(top) {
+        int v = stack[--top];
+        if(out) out[n] = F->data[v];
+        else printf("%c",F->data[v]);
+        n++;
+        for(int c = F->childStart[v + 1] - 1;c >= F->childStart[v];c--) stack[top++] = c;
+    }
+    free(stack);
+    return n;
+}
+
+/* 二进制文件 *************************************** */
+typedef struct {
+    char magic[4]; // "FRST"
+    int version;
+    long long numNodes,numRoots,loudsBits;
+    long long parentOffset,childOffset,dataOffset,loudsOffset,rankOffset,fileSize;
+} ForestFileHeader;
+
+long long AlignForest(long long offset) {
+    return (offset + FOREST_ALIGN - 1) / FOREST_ALIGN * FOREST_ALIGN;
+}
+
+void ForestLayout(ForestFileHeader *h) {
+    long long n = h->numNodes;
+    h->parentOffset = AlignForest(sizeof(ForestFileHeader));
+    h->childOffset = AlignForest(h->parentOffset + 4 * n);
+    h->dataOffset = AlignForest(h->childOffset + 4 * (n + 1));
+    h->loudsOffset = AlignForest(h->dataOffset + n);
+    h->rankOffset = AlignForest(h->loudsOffset + 8 * (LoudsWords(h->loudsBits) + 1));
+    h->fileSize = h->rankOffset + 4 * (LoudsBlocks(h->loudsBits) + 1);
+}
+
+int WriteSection(FILE *fp,long long offset,const void *data,size_t bytes) {
+    static const char zero[FOREST_ALIGN] = {0};
+    long long pad = offset - ftell(fp);
+    return fwrite(zero,1,pad,fp) == (size_t)pad && fwrite(data,1,bytes,fp) == bytes;
+}
+//要求已经BuildLouds
+int SaveCompactForest(const char *path,const CompactForest *F) {
+    FILE *fp = fopen(path,"wb");
+    if(!fp) {
+        printf("Cannot write %s\n",path);
+        return 0;
+    }
+    ForestFileHeader h;
+    memset(&h,0,sizeof(h));
+    memcpy(h.magic,"FRST",4);
+    h.version = 1;
+    h.numNodes = F->numNodes;
+    h.numRoots = F->numRoots;
+    h.loudsBits = F->loudsBits;
+    ForestLayout(&h);
+    long long n = F->numNodes;
+    int ok = fwrite(&h,sizeof(h),1,fp) == 1 && WriteSection(fp,h.parentOffset,F->parent,4 * n) &&
+             WriteSection(fp,h.childOffset,F->childStart,4 * (n + 1)) && WriteSection(fp,h.dataOffset,F->data,n) &&
+             WriteSection(fp,h.loudsOffset,F->louds,8 * (LoudsWords(h.loudsBits) + 1)) &&
+             WriteSection(fp,h.rankOffset,F->loudsRank,4 * (LoudsBlocks(h.loudsBits) + 1));
+    ok = fclose(fp) == 0 && ok;
+    return ok;
+}
+//F的数组指向映射内存，只读；用FreeCompactForest解除映射
+//映射进来的数组是否构成合法的层序森林：孩子区间首尾相接、孩子编号大于双亲，LOUDS和rank目录与childStart一致
+int ValidCompactForest(const CompactForest *F) {
+    int n = F->numNodes;
+    if(F->childStart[0] != F->numRoots || F->childStart[n] != n) return 0;
+    for(int r = 0;r < F->numRoots;r++) {
+        if(F->parent[r] != -1) return 0;
+    }
+    for(int v = 0;v < n;v++) {
+        if(F->childStart[v] > F->childStart[v + 1] || F->childStart[v] <= v) return 0;
+        for(int c = F->childStart[v];c < F->childStart[v + 1];c++) {
+            if(F->parent[c] != v) return 0;
+        }
+    }
+    long long p = 0;
+    for(int v = -1;v < n;v++) {
+        int d = v < 0 ? F->numRoots : Degree(F,v);
+        for(int k = 0;k <= d;k++,p++) {
+            if((int)(F->louds[p >> 6] >> (p & 63) & 1) != (k < d)) return 0;
+        }
+    }
+    //最后一个字的剩余位和末尾多出的一个字须为0，与BuildLouds写出的一致
+    long long words = LoudsWords(F->loudsBits);
+    if((p & 63) && F->louds[p >> 6] >> (p & 63)) return 0;
+    if(F->louds[words]) return 0;
+    unsigned ones = 0;
+    for(long long b = 0;b < LoudsBlocks(F->loudsBits);b++) {
+        if(F->loudsRank[b] != ones) return 0;
+        for(long long w = b * 8;w < words && w < b * 8 + 8;w++) ones += (unsigned)__builtin_popcountll(F->louds[w]);
+    }
+    return F->loudsRank[LoudsBlocks(F->loudsBits)] == ones;
+}
+
+int MapCompactForest(const char *path,CompactForest *F) {
+    InitCompactForest(F);
+    ForestFileHeader h;
+    char *base = NULL;
+    size_t length = 0;
+#ifdef _WIN32
+    FILE *fp = fopen(path,"rb");
+    if(!fp) return 0;
+    fseek(fp,0,SEEK_END);
+    length = (size_t)ftell(fp);
+    fseek(fp,0,SEEK_SET);
+    base = (char*)malloc(length > 0 ? length : 1);
+    if(!base || fread(base,1,length,fp) != length) {
+        free(base);
+        fclose(fp);
+        return 0;
+    }
+    fclose(fp);
+#else
+    int fd = open(path,O_RDONLY);
+    if(fd < 0) return 0;
+    struct stat st;
+    if(fstat(fd,&st) != 0 || st.st_size < (off_t)sizeof(h)) {
+        close(fd);
+        return 0;
+    }
+    length = (size_t)st.st_size;
+    void *p = mmap(NULL,length,PROT_READ,MAP_PRIVATE,fd,0);
+    close(fd);
+    if(p == MAP_FAILED) return 0;
+    base = (char*)p;
+#endif
+    F->mapping = base;
+    F->mappingSize = length;
+    int ok = length >= sizeof(h);
+    if(ok) {
+        memcpy(&h,base,sizeof(h));
+        ForestFileHeader expect = h;
+        ForestLayout(&expect);
+        ok = memcmp(h.magic,"FRST",4) == 0 && h.version == 1 && h.numNodes >= 0 && h.numNodes < 0x7fffffff &&
+             h.numRoots >= 0 && h.numRoots <= h.numNodes && h.loudsBits == 2 * h.numNodes + 1 &&
+             memcmp(&h,&expect,sizeof(h)) == 0 && (long long)length == h.fileSize;
+    }
+    if(ok) {
+        F->numNodes = (int)h.numNodes;
+        F->numRoots = (int)h.numRoots;
+        F->loudsBits = h.loudsBits;
+        F->parent = (int*)(base + h.parentOffset);
+        F->childStart = (int*)(base + h.childOffset);
+        F->data = base + h.dataOffset;
+        F->louds = (unsigned long long*)(base + h.loudsOffset);
+        F->loudsRank = (unsigned*)(base + h.rankOffset);
+        ok = ValidCompactForest(F);
+    }
+    if(!ok) {
+        printf("%s: bad forest file\n",path);
+        FreeCompactForest(F);
+    }
+    return ok;
+}
+#endif
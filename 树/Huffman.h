@@ -0,0 +1,454 @@
+#ifndef HUFFMAN_H
+#define HUFFMAN_H
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+/*
+字节流的范式哈夫曼编码
+哈夫曼树.c用'0''1'字符串表示编码，输出比输入大8倍，解码每读一位走一步树
+这里：
+1 只保存每个字节的码长，码字由码长唯一确定(范式哈夫曼)：
+  码长短的在前，同码长按字节值从小到大，码字依次加1，换码长时左移
+  文件头只需256个码长，每个4位，共128字节
+2 码长不超过HUFF_MAX_LEN，哈夫曼树超过时用package-merge求限长的最优码，保证解码表有界
+3 写入时位从低往高放进64位缓冲(码字按位反转存放)，攒够32位一次写出4字节
+4 解码时一次取HUFF_TABLE_BITS(11)位查表直接得到字节和码长，
+  码长超过11位的少数字节退回逐位的范式解码
+*/
+#define HUFF_SYMBOLS 256
+#define HUFF_MAX_LEN 15
+#define HUFF_TABLE_BITS 11
+#define HUFF_TABLE_SIZE (1 << HUFF_TABLE_BITS)
+#define HUFF_HEADER_BYTES (HUFF_SYMBOLS / 2)
+
+typedef struct {
+    uint8_t length[HUFF_SYMBOLS];
+    uint16_t code[HUFF_SYMBOLS]; // 按位反转后的码字，低位先写
+} HuffEncoder;
+
+typedef struct {
+    uint16_t table[HUFF_TABLE_SIZE]; // 字节<<4 | 码长，0表示码长超过查表位数
+    uint16_t count[HUFF_MAX_LEN + 1]; // 每种码长的字节个数
+    uint8_t sorted[HUFF_SYMBOLS]; // 按(码长,字节值)排好的字节
+} HuffDecoder;
+
+/* 码长 ********************************************** */
+//任意大小字母表(字、16位符号等)的建树，结点放在数组池中，下标即结点
+//0~n-1为叶子(符号)，合并出的内部结点依次编号n,n+1,...，孩子的下标总小于双亲
+typedef struct {
+    uint64_t *weight;
+    int *left,*right; // 叶子为-1
+    int count,capacity;
+} HuffArena;
+
+int InitArena(HuffArena *A,int numLeaves) {
+    A->capacity = 2 * numLeaves > 1 ? 2 * numLeaves : 2;
+    A->count = numLeaves;
+    A->weight = (uint64_t*)malloc(sizeof(uint64_t) * A->capacity);
+    A->left = (int*)malloc(sizeof(int) * A->capacity);
+    A->right = (int*)malloc(sizeof(int) * A->capacity);
+    if(!A->weight || !A->left || !A->right) return 0;
+    for(int i = 0;i < numLeaves;i++) A->left[i] = A->right[i] = -1;
+    return 1;
+}
+
+void FreeArena(HuffArena *A) {
+    free(A->weight);
+    free(A->left);
+    free(A->right);
+    A->weight = NULL;
+    A->left = A->right = NULL;
+}
+
+int NewInternal(HuffArena *A,int left,int right) {
+    int v = A->count++;
+    A->weight[v] = A->weight[left] + A->weight[right];
+    A->left[v] = left;
+    A->right[v] = right;
+    return v;
+}
+//小顶堆下沉，heap中存结点下标
+void SiftDown(const uint64_t *weight,int *heap,int size,int i) {
+    int x = heap[i];
+    while(2 * i + 1 < size) {
+        int c = 2 * i + 1;
+        if(c + 1 < size && weight[heap[c + 1]] < weight[heap[c]]) c++;
+        if(weight[heap[c]] >= weight[x]) break;
+        heap[i] = heap[c];
+        i = c;
+    }
+    heap[i] = x;
+}
+//堆建树 O(n log n)：建堆O(n)，每次弹出最小的，次小的堆顶直接换成合并结点再下沉
+//只用频率非零的符号，返回根，没有符号返回-1
+int BuildHeapTree(HuffArena *A,const uint64_t *freq,int n) {
+    int *heap = (int*)malloc(sizeof(int) * (n > 0 ? n : 1)),size = 0;
+    for(int s = 0;s < n;s++) {
+        A->weight[s] = freq[s];
+        if(freq[s]) heap[size++] = s;
+    }
+    for(int i = size / 2 - 1;i >= 0;i--) SiftDown(A->weight,heap,size,i);
+    while(size > 1) {
+        int a = heap[0];
+        heap[0] = heap[--size];
+        SiftDown(A->weight,heap,size,0);
+        heap[0] = NewInternal(A,a,heap[0]);
+        SiftDown(A->weight,heap,size,0);
+    }
+    int root = size ? heap[0] : -1;
+    free(heap);
+    return root;
+}
+//双队列建树 O(n)：order为频率非零的符号按频率从小到大排好的序列
+//合并出的结点权值单调不减，放进第二个队列，每次从两个队头取较小的即可
+int BuildTwoQueueTree(HuffArena *A,const uint64_t *freq,const int *order,int m) {
+    for(int i = 0;i < m;i++) A->weight[order[i]] = freq[order[i]];
+    if(m == 0) return -1;
+    int leaf = 0,head = A->count,pick[2];
+    for(int k = 0;k < m - 1;k++) {
+        for(int j = 0;j < 2;j++) {
+            if(head < A->count && (leaf == m || A->weight[head] < A->weight[order[leaf]])) pick[j] = head++;
+            else pick[j] = order[leaf++];
+        }
+        NewInternal(A,pick[0],pick[1]);
+    }
+    return m == 1 ? order[0] : A->count - 1;
+}
+//由树求每个符号的码长(深度)，只有一个符号时码长为1，返回最大码长
+int TreeLengths(const HuffArena *A,int root,int n,int *length) {
+    int *depth = (int*)malloc(sizeof(int) * A->count),maxLen = 0;
+    for(int s = 0;s < n;s++) length[s] = 0;
+    if(root < 0) {
+        free(depth);
+        return 0;
+    }
+    //双亲下标大于孩子，从根往下倒序求深度，没进树的叶子保持-1
+    for(int s = 0;s < n;s++) depth[s] = -1;
+    depth[root] = 0;
+    for(int v = root;v >= n;v--) {
+        depth[A->left[v]] = depth[A->right[v]] = depth[v] + 1;
+    }
+    for(int s = 0;s < n;s++) {
+        if(s == root) length[s] = 1;
+        else if(depth[s] > 0) length[s] = depth[s];
+        if(length[s] > maxLen) maxLen = length[s];
+    }
+    free(depth);
+    return maxLen;
+}
+
+typedef struct {
+    uint64_t weight;
+    int symbol;
+} WeightedSymbol;
+
+int CompareWeightedSymbol(const void *a,const void *b) {
+    const WeightedSymbol *x = (const WeightedSymbol*)a,*y = (const WeightedSymbol*)b;
+    if(x->weight != y->weight) return x->weight < y->weight ? -1 : 1;
+    return x->symbol - y->symbol;
+}
+//频率非零的符号按频率升序写入order，返回个数
+int SortByFrequency(const uint64_t *freq,int n,int *order) {
+    WeightedSymbol *items = (WeightedSymbol*)malloc(sizeof(WeightedSymbol) * (n > 0 ? n : 1));
+    int m = 0;
+    for(int s = 0;s < n;s++) {
+        if(freq[s]) {
+            items[m].weight = freq[s];
+            items[m++].symbol = s;
+        }
+    }
+    qsort(items,m,sizeof(WeightedSymbol),CompareWeightedSymbol);
+    for(int i = 0;i < m;i++) order[i] = items[i].symbol;
+    free(items);
+    return m;
+}
+//package-merge求码长不超过maxLen的最优前缀码，O(n*maxLen)
+//第0层为按频率升序的叶子；之后每层把上一层两两打包，再与叶子归并，只保留前2m-2项
+//取最后一层前2m-2项，往回看：某层选中项里的叶子都使对应符号码长加1，选中的包展开为上一层的前2k项
+//符号个数超过2^maxLen时无解返回0
+int PackageMerge(const uint64_t *freq,int n,int maxLen,int *length) {
+    int *order = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int m = SortByFrequency(freq,n,order);
+    for(int s = 0;s < n;s++) length[s] = 0;
+    if(m <= 2) {
+        for(int i = 0;i < m;i++) length[order[i]] = 1;
+        free(order);
+        return 1;
+    }
+    if(maxLen < 31 && m > (1 << maxLen)) {
+        free(order);
+        return 0;
+    }
+    int limit = 2 * m - 2;
+    uint64_t *prev = (uint64_t*)malloc(sizeof(uint64_t) * limit),*cur = (uint64_t*)malloc(sizeof(uint64_t) * limit);
+    char *isLeaf = (char*)malloc((size_t)maxLen * limit); // isLeaf[level*limit+j]：该层第j项是否为叶子
+    int prevLen = m;
+    for(int i = 0;i < m;i++) prev[i] = freq[order[i]];
+    for(int level = 1;level < maxLen;level++) {
+        char *flag = isLeaf + (size_t)level * limit;
+        int packages = prevLen / 2,leaf = 0,pack = 0,len = 0;
+        while(len < limit && (leaf < m || pack < packages)) {
+            uint64_t pw = pack < packages ? prev[2 * pack] + prev[2 * pack + 1] : 0;
+            if(pack == packages || (leaf < m && freq[order[leaf]] <= pw)) {
+                cur[len] = freq[order[leaf++]];
+                flag[len++] = 1;
+            } else {
+                cur[len] = pw;
+                flag[len++] = 0;
+                pack++;
+            }
+        }
+        uint64_t *tmp = prev;
+        prev = cur;
+        cur = tmp;
+        prevLen = len;
+    }
+    //往回展开
+    int take = limit;
+    for(int level = maxLen - 1;level >= 1;level--) {
+        const char *flag = isLeaf + (size_t)level * limit;
+        int leaves = 0;
+        for(int j = 0;j < take;j++) leaves += flag[j];
+        for(int i = 0;i < leaves;i++) length[order[i]]++;
+        take = 2 * (take - leaves);
+    }
+    for(int i = 0;i < take;i++) length[order[i]]++;
+    free(prev);
+    free(cur);
+    free(isLeaf);
+    free(order);
+    return 1;
+}
+//字节的码长：先用堆建树，最大码长超过HUFF_MAX_LEN时改用package-merge求限长最优码
+void HuffmanLengths(const uint64_t freq[HUFF_SYMBOLS],uint8_t length[HUFF_SYMBOLS]) {
+    int len[HUFF_SYMBOLS];
+    HuffArena A;
+    InitArena(&A,HUFF_SYMBOLS);
+    if(TreeLengths(&A,BuildHeapTree(&A,freq,HUFF_SYMBOLS),HUFF_SYMBOLS,len) > HUFF_MAX_LEN) {
+        PackageMerge(freq,HUFF_SYMBOLS,HUFF_MAX_LEN,len);
+    }
+    FreeArena(&A);
+    for(int s = 0;s < HUFF_SYMBOLS;s++) length[s] = (uint8_t)len[s];
+}
+//码长打包成4位一个，写入/读出文件头
+void PackLengths(const uint8_t length[HUFF_SYMBOLS],uint8_t header[HUFF_HEADER_BYTES]) {
+    for(int i = 0;i < HUFF_HEADER_BYTES;i++) {
+        header[i] = (uint8_t)(length[2 * i] | length[2 * i + 1] << 4);
+    }
+}
+
+void UnpackLengths(const uint8_t header[HUFF_HEADER_BYTES],uint8_t length[HUFF_SYMBOLS]) {
+    for(int i = 0;i < HUFF_HEADER_BYTES;i++) {
+        length[2 * i] = header[i] & 15;
+        length[2 * i + 1] = header[i] >> 4;
+    }
+}
+
+/* 范式码字 ****************************************** */
+uint16_t ReverseBits(uint16_t code,int length) {
+    uint16_t r = 0;
+    for(int i = 0;i < length;i++) {
+        r = (uint16_t)(r << 1 | (code & 1));
+        code >>= 1;
+    }
+    return r;
+}
+
+void InitEncoder(HuffEncoder *E,const uint8_t length[HUFF_SYMBOLS]) {
+    int count[HUFF_MAX_LEN + 1] = {0};
+    uint16_t next[HUFF_MAX_LEN + 2];
+    memcpy(E->length,length,HUFF_SYMBOLS);
+    for(int s = 0;s < HUFF_SYMBOLS;s++) count[length[s]]++;
+    count[0] = 0;
+    //每种码长的第一个码字
+    next[1] = 0;
+    for(int len = 1;len < HUFF_MAX_LEN;len++) {
+        next[len + 1] = (uint16_t)((next[len] + count[len]) << 1);
+    }
+    for(int s = 0;s < HUFF_SYMBOLS;s++) {
+        E->code[s] = length[s] ? ReverseBits(next[length[s]]++,length[s]) : 0;
+    }
+}
+//检查码长是否构成前缀码(Kraft不等式)，填查表。码长非法返回0
+int InitDecoder(HuffDecoder *D,const uint8_t length[HUFF_SYMBOLS]) {
+    HuffEncoder E;
+    int used = 0,left = 1,index[HUFF_MAX_LEN + 1];
+    memset(D,0,sizeof(HuffDecoder));
+    for(int s = 0;s < HUFF_SYMBOLS;s++) {
+        if(length[s] > HUFF_MAX_LEN) return 0;
+        if(length[s]) {
+            D->count[length[s]]++;
+            used++;
+        }
+    }
+    for(int len = 1;len <= HUFF_MAX_LEN;len++) {
+        left = (left << 1) - D->count[len];
+        if(left < 0) return 0; // 码字不够分
+    }
+    //不完全的码只允许只有一个字节的情况
+    if(left > 0 && used > 1) return 0;
+    index[1] = 0;
+    for(int len = 1;len < HUFF_MAX_LEN;len++) index[len + 1] = index[len] + D->count[len];
+    for(int s = 0;s < HUFF_SYMBOLS;s++) {
+        if(length[s]) D->sorted[index[length[s]]++] = (uint8_t)s;
+    }
+    //码长不超过11位的字节：低length位为反转码字的所有表项都指向它
+    InitEncoder(&E,length);
+    for(int s = 0;s < HUFF_SYMBOLS;s++) {
+        int len = length[s];
+        if(len == 0 || len > HUFF_TABLE_BITS) continue;
+        for(int i = E.code[s];i < HUFF_TABLE_SIZE;i += 1 << len) {
+            D->table[i] = (uint16_t)(s << 4 | len);
+        }
+    }
+    return 1;
+}
+
+/* 位写入 ******************************************** */
+typedef struct {
+    uint64_t buffer;
+    int bits; // buffer中待写出的位数，写码字前总小于32
+    uint8_t *out;
+    size_t pos;
+} BitWriter;
+
+void InitBitWriter(BitWriter *W,uint8_t *out) {
+    W->buffer = 0;
+    W->bits = 0;
+    W->out = out;
+    W->pos = 0;
+}
+//编码n个字节追加到W->out，out至少要有 n*HUFF_MAX_LEN/8+8 字节空余
+void HuffmanEncode(const HuffEncoder *E,BitWriter *W,const uint8_t *in,size_t n) {
+    uint64_t buffer = W->buffer;
+    int bits = W->bits;
+    uint8_t *out = W->out + W->pos;
+    for(size_t i = 0;i < n;i++) {
+        buffer |= (uint64_t)E->code[in[i]] << bits;
+        bits += E->length[in[i]];
+        if(bits >= 32) {
+            uint32_t word = (uint32_t)buffer;
+            out[0] = (uint8_t)word;
+            out[1] = (uint8_t)(word >> 8);
+            out[2] = (uint8_t)(word >> 16);
+            out[3] = (uint8_t)(word >> 24);
+            out += 4;
+            buffer >>= 32;
+            bits -= 32;
+        }
+    }
+    W->buffer = buffer;
+    W->bits = bits;
+    W->pos = (size_t)(out - W->out);
+}
+//把已写满的字节移走后调用者可以复用out，残留不足一字节的位留在buffer中
+void FlushBitWriter(BitWriter *W,int final) {
+    while(W->bits >= 8 || (final && W->bits > 0)) {
+        W->out[W->pos++] = (uint8_t)W->buffer;
+        W->buffer >>= 8;
+        W->bits = W->bits >= 8 ? W->bits - 8 : 0;
+    }
+}
+
+/* 位读取 ******************************************** */
+//fp非空时data为读缓冲，不够时从文件补；fp为空时data为整块内存
+typedef struct {
+    const uint8_t *data;
+    size_t pos,size;
+    uint64_t buffer;
+    int bits;
+    FILE *fp;
+    uint8_t *own; // 读文件时自己申请的缓冲
+    size_t capacity;
+    size_t overrun; // 读到数据末尾后补的0字节数
+} BitReader;
+
+void InitBitReader(BitReader *R,const uint8_t *data,size_t size) {
+    memset(R,0,sizeof(BitReader));
+    R->data = data;
+    R->size = size;
+}
+
+int InitFileBitReader(BitReader *R,FILE *fp,size_t capacity) {
+    memset(R,0,sizeof(BitReader));
+    R->own = (uint8_t*)malloc(capacity);
+    if(!R->own) return 0;
+    R->fp = fp;
+    R->capacity = capacity;
+    R->data = R->own;
+    return 1;
+}
+
+void FreeBitReader(BitReader *R) {
+    free(R->own);
+    R->own = NULL;
+}
+//保证buffer中至少有56位
+void Refill(BitReader *R) {
+    if(R->bits >= 56) return;
+    if(R->fp && R->size - R->pos < 8) {
+        //剩余字节挪到开头，再从文件读满
+        size_t rest = R->size - R->pos;
+        memmove(R->own,R->own + R->pos,rest);
+        R->size = rest + fread(R->own + rest,1,R->capacity - rest,R->fp);
+        R->pos = 0;
+    }
+    if(R->size - R->pos >= 8) {
+        uint64_t word;
+        memcpy(&word,R->data + R->pos,8); // 小端
+        R->buffer |= word << R->bits;
+        int bytes = (63 - R->bits) >> 3;
+        R->pos += bytes;
+        R->bits += bytes << 3;
+        return;
+    }
+    while(R->bits <= 56) {
+        uint64_t byte = 0;
+        if(R->pos < R->size) byte = R->data[R->pos++];
+        else R->overrun++;
+        R->buffer |= byte << R->bits;
+        R->bits += 8;
+    }
+}
+//码长超过查表位数时逐位做范式解码，失败返回-1
+int DecodeSlow(const HuffDecoder *D,BitReader *R) {
+    int code = 0,first = 0,index = 0;
+    for(int len = 1;len <= HUFF_MAX_LEN;len++) {
+        code |= (int)(R->buffer >> (len - 1)) & 1;
+        int count = D->count[len];
+        if(code - first < count) {
+            R->buffer >>= len;
+            R->bits -= len;
+            return D->sorted[index + code - first];
+        }
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+    return -1;
+}
+//解码n个字节到out，数据损坏返回0
+int HuffmanDecode(const HuffDecoder *D,BitReader *R,uint8_t *out,size_t n) {
+    for(size_t i = 0;i < n;) {
+        Refill(R);
+        //56位至少够3个码字
+        for(int k = 0;k < 3 && i < n;k++) {
+            uint16_t entry = D->table[R->buffer & (HUFF_TABLE_SIZE - 1)];
+            if(entry) {
+                out[i++] = (uint8_t)(entry >> 4);
+                R->buffer >>= entry & 15;
+                R->bits -= entry & 15;
+            } else {
+                int s = DecodeSlow(D,R);
+                if(s < 0) return 0;
+                out[i++] = (uint8_t)s;
+            }
+        }
+        //超出数据末尾8字节以上说明码流被截断
+        if(R->overrun > 8) return 0;
+    }
+    //末尾补的0不能被当作码字用掉：补进来的位必须都还留在buffer里
+    return R->overrun * 8 <= (size_t)R->bits;
+}
+#endif
@@ -0,0 +1,221 @@
+#ifndef INDEX_TREE_H
+#define INDEX_TREE_H
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/*
+下标二叉树：所有结点放在一个连续数组(结点池)里，孩子用32位下标代替指针
+链表二叉树.c的TreeNode每个结点单独malloc，两个8字节指针只为存1字节数据，
+加上malloc的头部每个结点约32字节，且散落在堆上
+这里每个结点12字节，按前序依次分配时前序遍历就是顺序访问数组
+删除的结点串成空闲链表(用leftChild链接)，再分配时优先复用
+数组扩容时只是realloc搬家，下标不变(指针会失效)
+遍历都用显式栈，栈深度不超过结点数，不会像递归那样在深树上栈溢出
+遍历结果写入out数组(out为NULL时直接打印)，返回写入的结点数
+*/
+#define NIL -1
+
+typedef struct {
+    char data;
+    int leftChild,rightChild; // 孩子下标，没有为NIL
+} IndexNode;
+
+typedef struct {
+    IndexNode *node;
+    int count; // 用过的最大下标+1
+    int capacity;
+    int used; // 在用的结点数
+    int freeList; // 空闲结点链表头
+    int root;
+} IndexTree;
+
+int InitIndexTree(IndexTree *T,int capacity) {
+    T->capacity = capacity > 0 ? capacity : 16;
+    T->node = (IndexNode*)malloc(sizeof(IndexNode) * T->capacity);
+    T->count = T->used = 0;
+    T->freeList = NIL;
+    T->root = NIL;
+    return T->node != NULL;
+}
+
+void DestroyIndexTree(IndexTree *T) {
+    free(T->node);
+    T->node = NULL;
+    T->count = T->capacity = T->used = 0;
+    T->freeList = T->root = NIL;
+}
+//分配一个结点，失败返回NIL
+int NewIndexNode(IndexTree *T,char data) {
+    int i;
+    if(T->freeList != NIL) {
+        i = T->freeList;
+        T->freeList = T->node[i].leftChild;
+    } else {
+        if(T->count == T->capacity) {
+            IndexNode *grown = (IndexNode*)realloc(T->node,sizeof(IndexNode) * T->capacity * 2);
+            if(!grown) return NIL;
+            T->node = grown;
+            T->capacity *= 2;
+        }
+        i = T->count++;
+    }
+    T->node[i].data = data;
+    T->node[i].leftChild = T->node[i].rightChild = NIL;
+    T->used++;
+    return i;
+}
+//遍历用的栈，最多放下所有在用结点
+int *NewIndexStack(const IndexTree *T) {
+    return (int*)malloc(sizeof(int) * (T->used + 1));
+}
+//释放以i为根的子树，结点进空闲链表。调用者负责把双亲中指向i的下标置为NIL
+void FreeSubtree(IndexTree *T,int i) {
+    if(i == NIL) return;
+    int *stack = NewIndexStack(T),top = 0;
+    stack[top++] = i;
+    while(top) {
+        int v = stack[--top];
+        if(T->node[v].leftChild != NIL) stack[top++] = T->node[v].leftChild;
+        if(T->node[v].rightChild != NIL) stack[top++] = T->node[v].rightChild;
+        T->node[v].leftChild = T->freeList;
+        T->freeList = v;
+        T->used--;
+    }
+    free(stack);
+    if(T->root == i) T->root = NIL;
+}
+
+/* 构造 ********************************************* */
+//同CreateTree：按前序读串，#为空。用栈记录待填的孩子位置(双亲下标*2+0左/1右，-1为根)
+//结点按前序依次分配。串不完整或多余时返回0
+int CreateIndexTree(IndexTree *T,const char *chars,int length) {
+    int *slot = (int*)malloc(sizeof(int) * (length + 1)),top = 0,i = 0;
+    FreeSubtree(T,T->root);
+    slot[top++] = -1;
+    while(top && i < length) {
+        int s = slot[--top];
+        char ch = chars[i++];
+        int v = NIL;
+        if(ch != '#') {
+            v = NewIndexNode(T,ch);
+            if(v == NIL) break;
+            //先填左孩子，所以右孩子的位置先入栈
+            slot[top++] = v * 2 + 1;
+            slot[top++] = v * 2;
+        }
+        if(s == -1) T->root = v;
+        else if(s % 2 == 0) T->node[s / 2].leftChild = v;
+        else T->node[s / 2].rightChild = v;
+    }
+    int complete = top == 0 && i == length;
+    free(slot);
+    return complete;
+}
+//由链表二叉树.c的String(0号单元存长度)构造
+int CreateIndexTreeFromString(IndexTree *T,const char *S) {
+    return CreateIndexTree(T,S + 1,(unsigned char)S[0]);
+}
+
+/* 遍历 ********************************************* */
+int Emit(char *out,int n,char data) {
+    if(out) out[n] = data;
+    else printf("%c",data);
+    return n + 1;
+}
+//前序：弹出即访问，先压右再压左
+int GetHead(const IndexTree *T,char *out) {
+    if(T->root == NIL) return 0;
+    int *stack = NewIndexStack(T),top = 0,n = 0;
+    stack[top++] = T->root;
+    while(top) {
+        const IndexNode *E = &T->node[stack[--top]];
+        n = Emit(out,n,E->data);
+        if(E->rightChild != NIL) stack[top++] = E->rightChild;
+        if(E->leftChild != NIL) stack[top++] = E->leftChild;
+    }
+    free(stack);
+    return n;
+}
+//中序：一路向左入栈，弹出访问后转向右子树
+int GetMiddle(const IndexTree *T,char *out) {
+    int *stack = NewIndexStack(T),top = 0,n = 0,v = T->root;
+    while(v != NIL || top) {
+        if(v != NIL) {
+            stack[top++] = v;
+            v = T->node[v].leftChild;
+        } else {
+            v = stack[--top];
+            n = Emit(out,n,T->node[v].data);
+            v = T->node[v].rightChild;
+        }
+    }
+    free(stack);
+    return n;
+}
+//后序：栈顶结点的右子树为空或刚访问过才访问它
+int GetTail(const IndexTree *T,char *out) {
+    int *stack = NewIndexStack(T),top = 0,n = 0,v = T->root,prv = NIL;
+    while(v != NIL || top) {
+        if(v != NIL) {
+            stack[top++] = v;
+            v = T->node[v].leftChild;
+        } else {
+            int E = stack[top - 1];
+            if(T->node[E].rightChild == NIL || T->node[E].rightChild == prv) {
+                n = Emit(out,n,T->node[E].data);
+                prv = E;
+                top--;
+            } else {
+                v = T->node[E].rightChild;
+            }
+        }
+    }
+    free(stack);
+    return n;
+}
+//层序：队列也是一个下标数组，每个结点只入队一次，不需要循环队列
+int GetLayer(const IndexTree *T,char *out) {
+    if(T->root == NIL) return 0;
+    int *queue = NewIndexStack(T),head = 0,tail = 0,n = 0;
+    queue[tail++] = T->root;
+    while(head < tail) {
+        const IndexNode *E = &T->node[queue[head++]];
+        n = Emit(out,n,E->data);
+        if(E->leftChild != NIL) queue[tail++] = E->leftChild;
+        if(E->rightChild != NIL) queue[tail++] = E->rightChild;
+    }
+    free(queue);
+    return n;
+}
+//高度：按层扫描，层数即高度
+int Height(const IndexTree *T) {
+    if(T->root == NIL) return 0;
+    int *queue = NewIndexStack(T),head = 0,tail = 0,height = 0;
+    queue[tail++] = T->root;
+    while(head < tail) {
+        int end = tail;
+        height++;
+        for(;head < end;head++) {
+            const IndexNode *E = &T->node[queue[head]];
+            if(E->leftChild != NIL) queue[tail++] = E->leftChild;
+            if(E->rightChild != NIL) queue[tail++] = E->rightChild;
+        }
+    }
+    free(queue);
+    return height;
+}
+//结点数：从根出发能走到的结点。池里可能还有没挂到根下的结点，不能直接用used
+int NodeCount(const IndexTree *T) {
+    if(T->root == NIL) return 0;
+    int *stack = NewIndexStack(T),top = 0,n = 0;
+    stack[top++] = T->root;
+    while(top) {
+        const IndexNode *E = &T->node[stack[--top]];
+        n++;
+        if(E->leftChild != NIL) stack[top++] = E->leftChild;
+        if(E->rightChild != NIL) stack[top++] = E->rightChild;
+    }
+    free(stack);
+    return n;
+}
+#endif
@@ -83,6 +83,7 @@ int lengths(Tree node[],int length) {
     return count;
 }
 //构建哈夫曼树
+//每次合并都扫描全部结点，O(n^2)；堆、双队列与限长(package-merge)的构造见 进阶补充题/哈夫曼树构造(堆 双队列 package-merge).c
 void Create(Tree *T,Tree node[],int length) {
     //作为根节点
     if(lengths(node,length) == 1) {
@@ -163,6 +164,7 @@ void GetCode(Tree T,char code[],int length) {
     }
 }
 //设计一个小系统，通过扫描一段字符串获得相关字符的权重，以此实现对文本的压缩，并同时构建出相应的解压缩功能，以还原所压缩文本
+//按字节压缩任意文件的范式哈夫曼编码(位打包 查表解码)见 进阶补充题/哈夫曼文件压缩(范式编码 查表解码).c
 //编码
 void Transfer(char str[],int len,char HfmCode[]) {
     //初始化
@@ -44,6 +44,7 @@ typedef struct TreeNode {
                 K
    */
 
+//转换为层序数组存储(CompactForest.h)见 进阶补充题/紧凑森林(双亲数组 CSR LOUDS mmap).c 的FromChildTree
 void Transfer(Tree T, BiTree *B) {
     // 初始化二叉树根节点
     *B = (BiTree)malloc(sizeof(TreeNode));
@@ -172,6 +172,7 @@ Status isEmpty(Queue Q) {
     }
 }
 
+//队列定长MAXSIZES，宽树会溢出；可扩容环形队列、逐层回调、并行按层展开的版本见 进阶补充题/层序遍历引擎(环形队列 逐层回调 并行扩展).c
 void GetLayer(Tree T) {
     Queue Q;
     InitQueue(&Q);
@@ -215,6 +216,7 @@ void GetLayerForest(Forest F) {
     }
 }
 
+//层序数组(双亲+孩子起点CSR、LOUDS)存储、可mmap加载的版本见 CompactForest.h 与 进阶补充题/紧凑森林(双亲数组 CSR LOUDS mmap).c
 int HeightUpdate(Forest F) {
     Queue Q;
     InitQueue(&Q);
@@ -90,6 +90,7 @@ Status GetTail(Tree T) {
 Tree treePre = NULL;
 
 //构建线索化
+//插入删除时同步维护线索、带游标和区间扫描的中序线索有序集合见 进阶补充题/线索有序集合(游标 插入删除 区间扫描).c
 void MiddleThread(Tree T) {
     if(T != NULL) {
         MiddleThread(T->leftChild);
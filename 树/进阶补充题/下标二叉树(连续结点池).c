@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../IndexTree.h"
+/*
+下标二叉树与链表二叉树对比
+同一个前序串分别建成链表二叉树.c的TreeNode(每个结点malloc)与IndexTree.h的结点池，
+比较占用内存与各遍历的耗时，并检查遍历结果一致
+*/
+typedef char String[24]; /*  0号单元存放串的长度 */
+
+typedef struct TreeNode {
+    char data;
+    struct TreeNode *leftChild,*rightChild;
+} TreeNode,*Tree;
+
+/* 链表二叉树(对照) ******************************** */
+//与CreateTree相同的前序建树，用栈代替递归，以便建很大的树
+//pool非空时从pool中依次取结点(模拟长期运行后堆上分散的结点)，否则逐个malloc
+Tree CreateLinkedTree(const char *chars,int length,Tree *pool) {
+    Tree root = NULL;
+    Tree **slot = (Tree**)malloc(sizeof(Tree*) * (length + 1));
+    int top = 0;
+    slot[top++] = &root;
+    for(int i = 0;top && i < length;i++) {
+        Tree *s = slot[--top];
+        if(chars[i] == '#') {
+            *s = NULL;
+        } else {
+            *s = pool ? *pool++ : (Tree)malloc(sizeof(TreeNode));
+            (*s)->data = chars[i];
+            slot[top++] = &(*s)->rightChild;
+            slot[top++] = &(*s)->leftChild;
+        }
+    }
+    free(slot);
+    return root;
+}
+
+void DestroyLinkedTree(Tree T) {
+    if(T) {
+        DestroyLinkedTree(T->leftChild);
+        DestroyLinkedTree(T->rightChild);
+        free(T);
+    }
+}
+//链表二叉树.c中递归的遍历，改为写入out
+int LinkedHead(Tree T,char *out,int n) {
+    if(T != NULL) {
+        out[n++] = T->data;
+        n = LinkedHead(T->leftChild,out,n);
+        n = LinkedHead(T->rightChild,out,n);
+    }
+    return n;
+}
+
+int LinkedMiddle(Tree T,char *out,int n) {
+    if(T != NULL) {
+        n = LinkedMiddle(T->leftChild,out,n);
+        out[n++] = T->data;
+        n = LinkedMiddle(T->rightChild,out,n);
+    }
+    return n;
+}
+
+int LinkedTail(Tree T,char *out,int n) {
+    if(T != NULL) {
+        n = LinkedTail(T->leftChild,out,n);
+        n = LinkedTail(T->rightChild,out,n);
+        out[n++] = T->data;
+    }
+    return n;
+}
+
+int LinkedLayer(Tree T,char *out,int numNodes) {
+    Tree *queue = (Tree*)malloc(sizeof(Tree) * (numNodes + 1));
+    int head = 0,tail = 0;
+    if(T) queue[tail++] = T;
+    while(head < tail) {
+        Tree E = queue[head];
+        out[head++] = E->data;
+        if(E->leftChild) queue[tail++] = E->leftChild;
+        if(E->rightChild) queue[tail++] = E->rightChild;
+    }
+    free(queue);
+    return head;
+}
+
+int LinkedHeight(Tree T) {
+    if(T == NULL) return 0;
+    int l = LinkedHeight(T->leftChild),r = LinkedHeight(T->rightChild);
+    return (l > r ? l : r) + 1;
+}
+
+int LinkedNodeCount(Tree T) {
+    return T ? LinkedNodeCount(T->leftChild) + LinkedNodeCount(T->rightChild) + 1 : 0;
+}
+
+/* 演示 ********************************************* */
+//随机形状的树的前序串：栈中存子树大小，左子树大小在[0,size-1]中随机
+int RandomPreorder(char *chars,int numNodes) {
+    int *stack = (int*)malloc(sizeof(int) * (numNodes + 2)),top = 0,length = 0;
+    stack[top++] = numNodes;
+    while(top) {
+        int size = stack[--top];
+        if(size == 0) {
+            chars[length++] = '#';
+            continue;
+        }
+        int left = (int)(((unsigned)rand() * 32768u + rand()) % size);
+        chars[length++] = (char)('A' + rand() % 26);
+        stack[top++] = size - 1 - left;
+        stack[top++] = left;
+    }
+    free(stack);
+    return length;
+}
+
+double Elapsed(clock_t begin) {
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    //链表二叉树.c中的例子
+    String str;
+    const char *example = "AB#CD#E###FG#HI#J####";
+    str[0] = (char)strlen(example);
+    memcpy(str + 1,example,str[0]);
+    IndexTree T;
+    InitIndexTree(&T,16);
+    CreateIndexTreeFromString(&T,str);
+    printf("Head   ");
+    GetHead(&T,NULL);
+    printf("\nMiddle ");
+    GetMiddle(&T,NULL);
+    printf("\nTail   ");
+    GetTail(&T,NULL);
+    printf("\nLayer  ");
+    GetLayer(&T,NULL);
+    printf("\nHeight = %d Node Count = %d\n",Height(&T),NodeCount(&T));
+    //删掉根的右子树，新结点复用空闲链表中的位置
+    int right = T.node[T.root].rightChild;
+    T.node[T.root].rightChild = NIL;
+    FreeSubtree(&T,right);
+    T.node[T.root].rightChild = NewIndexNode(&T,'Z');
+    printf("Replace right subtree with Z: ");
+    GetHead(&T,NULL);
+    printf(" (pool slots %d, used %d)\n",T.count,T.used);
+
+    //大树
+    printf("\n*******\n");
+    srand(2024);
+    int n = 2000000;
+    char *chars = (char*)malloc(2 * n + 1);
+    int length = RandomPreorder(chars,n);
+    char *a = (char*)malloc(n),*b = (char*)malloc(n);
+    clock_t begin = clock();
+    Tree L = CreateLinkedTree(chars,length,NULL);
+    double linkedBuild = Elapsed(begin);
+    //先malloc所有结点再打乱使用顺序，相邻结点不再相邻
+    Tree *pool = (Tree*)malloc(sizeof(Tree) * n);
+    for(int i = 0;i < n;i++) pool[i] = (Tree)malloc(sizeof(TreeNode));
+    for(int i = n - 1;i > 0;i--) {
+        int j = (int)(((unsigned)rand() * 32768u + rand()) % (i + 1));
+        Tree tmp = pool[i];
+        pool[i] = pool[j];
+        pool[j] = tmp;
+    }
+    Tree S = CreateLinkedTree(chars,length,pool);
+    begin = clock();
+    CreateIndexTree(&T,chars,length);
+    double indexBuild = Elapsed(begin);
+    //glibc中malloc(24)实际占32字节(8字节头部，16字节对齐)
+    printf("n=%d build linked %.3fs index %.3fs\n",n,linkedBuild,indexBuild);
+    printf("memory linked %.1f MB (malloc'd 24B nodes) index %.1f MB (%d x %d B)\n",n * 32.0 / 1048576,
+           T.capacity * (double)sizeof(IndexNode) / 1048576,T.capacity,(int)sizeof(IndexNode));
+    const char *name[] = {"Head","Middle","Tail","Layer"};
+    printf("         linked(fresh heap) linked(scattered) index\n");
+    for(int k = 0;k < 4;k++) {
+        int x = 0,y;
+        double linkedTime[2];
+        for(int j = 0;j < 2;j++) {
+            Tree R = j == 0 ? L : S;
+            begin = clock();
+            if(k == 0) x = LinkedHead(R,a,0);
+            else if(k == 1) x = LinkedMiddle(R,a,0);
+            else if(k == 2) x = LinkedTail(R,a,0);
+            else x = LinkedLayer(R,a,n);
+            linkedTime[j] = Elapsed(begin);
+        }
+        begin = clock();
+        if(k == 0) y = GetHead(&T,b);
+        else if(k == 1) y = GetMiddle(&T,b);
+        else if(k == 2) y = GetTail(&T,b);
+        else y = GetLayer(&T,b);
+        double indexTime = Elapsed(begin);
+        printf("%-8s %.3fs             %.3fs            %.3fs %s\n",name[k],linkedTime[0],linkedTime[1],indexTime,
+               x == y && memcmp(a,b,x) == 0 ? "OK" : "MISMATCH");
+    }
+    begin = clock();
+    int h1 = LinkedHeight(S),c1 = LinkedNodeCount(S);
+    double linkedTime = Elapsed(begin);
+    begin = clock();
+    int h2 = Height(&T),c2 = NodeCount(&T);
+    printf("Height+NodeCount scattered %.3fs index %.3fs height %d/%d count %d/%d\n",linkedTime,Elapsed(begin),h1,h2,c1,c2);
+    DestroyLinkedTree(L);
+    DestroyLinkedTree(S);
+    free(pool);
+    DestroyIndexTree(&T);
+    free(chars);
+    free(a);
+    free(b);
+    return 0;
+}
@@ -0,0 +1,388 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../Huffman.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+/*
+分块并行的哈夫曼压缩
+哈夫曼文件压缩(范式编码 查表解码).c整个文件用一张码表，只能单线程从头编到尾、从头解到尾
+这里把输入切成BLOCK(1 MiB)的块，每块独立统计频率、建码表、编码，块之间没有依赖：
+1 一次读入一批块，编译时加-fopenmp则用OpenMP线程池并行处理各块，再按顺序写出
+2 每块前有自己的128字节码长表；压缩后不变小的块直接原样存储(码长全为0)
+3 文件末尾是块索引(每块在文件中的位置、压缩后与原始长度)，解压同样可以并行，
+  也可以只读索引后直接解出任意一块(随机访问)
+文件格式：
+  "HUFB" | 块大小(4字节) | 各块 | 索引：每块{位置8字节,压缩长4字节,原长4字节} | 块数8字节 | 原长8字节 | 索引位置8字节 | "HUFB"
+用法：哈夫曼分块并行压缩 c 输入 输出 / 哈夫曼分块并行压缩 d 输入 输出，不带参数时跑演示
+*/
+#define OK 1
+#define ERROR 0
+#define BLOCK (1 << 20)
+#define BATCH 64 // 每批读入的块数
+#define TRAILER_BYTES 28
+#define MAX_BLOCK (64 << 20) // 读文件时接受的最大块大小
+
+typedef int Status;
+
+typedef struct {
+    uint64_t offset; // 块在文件中的位置
+    uint32_t packed,raw;
+} BlockEntry;
+
+typedef struct {
+    BlockEntry *entry;
+    uint64_t count,capacity;
+    uint64_t total;
+    uint32_t blockSize;
+} BlockIndex;
+
+double Now() {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+void PutU32(uint8_t *p,uint32_t x) {
+    for(int i = 0;i < 4;i++) p[i] = (uint8_t)(x >> (8 * i));
+}
+
+void PutU64(uint8_t *p,uint64_t x) {
+    for(int i = 0;i < 8;i++) p[i] = (uint8_t)(x >> (8 * i));
+}
+
+uint32_t GetU32(const uint8_t *p) {
+    uint32_t x = 0;
+    for(int i = 0;i < 4;i++) x |= (uint32_t)p[i] << (8 * i);
+    return x;
+}
+
+uint64_t GetU64(const uint8_t *p) {
+    uint64_t x = 0;
+    for(int i = 0;i < 8;i++) x |= (uint64_t)p[i] << (8 * i);
+    return x;
+}
+
+/* 单块 ********************************************** */
+//压缩一块到out(至少HUFF_HEADER_BYTES + n*HUFF_MAX_LEN/8 + 8字节)，返回压缩后字节数
+uint32_t EncodeBlock(const uint8_t *in,uint32_t n,uint8_t *out) {
+    uint64_t freq[HUFF_SYMBOLS] = {0};
+    uint8_t length[HUFF_SYMBOLS];
+    for(uint32_t i = 0;i < n;i++) freq[in[i]]++;
+    HuffmanLengths(freq,length);
+    //估算编码后的位数，不变小就原样存储
+    uint64_t bits = 0;
+    for(int s = 0;s < HUFF_SYMBOLS;s++) bits += freq[s] * length[s];
+    if((bits + 7) / 8 >= n) {
+        memset(out,0,HUFF_HEADER_BYTES);
+        memcpy(out + HUFF_HEADER_BYTES,in,n);
+        return HUFF_HEADER_BYTES + n;
+    }
+    HuffEncoder E;
+    BitWriter W;
+    InitEncoder(&E,length);
+    PackLengths(length,out);
+    InitBitWriter(&W,out + HUFF_HEADER_BYTES);
+    HuffmanEncode(&E,&W,in,n);
+    FlushBitWriter(&W,1);
+    return (uint32_t)(HUFF_HEADER_BYTES + W.pos);
+}
+//解压一块，数据损坏返回0
+int DecodeBlock(const uint8_t *in,uint32_t packed,uint8_t *out,uint32_t raw) {
+    uint8_t length[HUFF_SYMBOLS];
+    HuffDecoder D;
+    BitReader R;
+    if(packed < HUFF_HEADER_BYTES) return 0;
+    UnpackLengths(in,length);
+    int stored = 1;
+    for(int s = 0;s < HUFF_SYMBOLS;s++) {
+        if(length[s]) stored = 0;
+    }
+    if(stored) {
+        if(packed - HUFF_HEADER_BYTES != raw) return 0;
+        memcpy(out,in + HUFF_HEADER_BYTES,raw);
+        return 1;
+    }
+    if(!InitDecoder(&D,length)) return 0;
+    InitBitReader(&R,in + HUFF_HEADER_BYTES,packed - HUFF_HEADER_BYTES);
+    return HuffmanDecode(&D,&R,out,raw);
+}
+
+/* 压缩 ********************************************** */
+Status AddEntry(BlockIndex *I,uint64_t offset,uint32_t packed,uint32_t raw) {
+    if(I->count == I->capacity) {
+        uint64_t capacity = I->capacity ? I->capacity * 2 : 64;
+        BlockEntry *grown = (BlockEntry*)realloc(I->entry,sizeof(BlockEntry) * capacity);
+        if(!grown) return ERROR;
+        I->entry = grown;
+        I->capacity = capacity;
+    }
+    I->entry[I->count].offset = offset;
+    I->entry[I->count].packed = packed;
+    I->entry[I->count++].raw = raw;
+    I->total += raw;
+    return OK;
+}
+
+Status CompressFile(const char *inPath,const char *outPath,uint64_t *total) {
+    FILE *in = fopen(inPath,"rb");
+    if(!in) return ERROR;
+    FILE *out = fopen(outPath,"wb");
+    if(!out) {
+        fclose(in);
+        return ERROR;
+    }
+    size_t packedCapacity = HUFF_HEADER_BYTES + (size_t)BLOCK / 8 * HUFF_MAX_LEN + 16;
+    uint8_t *raw = (uint8_t*)malloc((size_t)BLOCK * BATCH);
+    uint8_t *packed = (uint8_t*)malloc(packedCapacity * BATCH);
+    uint32_t rawSize[BATCH],packedSize[BATCH];
+    Status status = raw && packed ? OK : ERROR;
+    BlockIndex I;
+    memset(&I,0,sizeof(BlockIndex));
+    uint8_t head[8];
+    memcpy(head,"HUFB",4);
+    PutU32(head + 4,BLOCK);
+    fwrite(head,1,8,out);
+    uint64_t offset = 8;
+    size_t n;
+    while(status == OK && (n = fread(raw,1,(size_t)BLOCK * BATCH,in)) > 0) {
+        int blocks = (int)((n + BLOCK - 1) / BLOCK);
+        for(int b = 0;b < blocks;b++) {
+            rawSize[b] = (uint32_t)(n - (size_t)b * BLOCK < BLOCK ? n - (size_t)b * BLOCK : BLOCK);
+        }
+        #pragma omp parallel for schedule(dynamic,1)
+        for(int b = 0;b < blocks;b++) {
+            packedSize[b] = EncodeBlock(raw + (size_t)b * BLOCK,rawSize[b],packed + packedCapacity * b);
+        }
+        for(int b = 0;b < blocks;b++) {
+            fwrite(packed + packedCapacity * b,1,packedSize[b],out);
+            if(!AddEntry(&I,offset,packedSize[b],rawSize[b])) status = ERROR;
+            offset += packedSize[b];
+        }
+    }
+    //索引和尾部
+    uint8_t item[16],trailer[TRAILER_BYTES];
+    for(uint64_t k = 0;k < I.count;k++) {
+        PutU64(item,I.entry[k].offset);
+        PutU32(item + 8,I.entry[k].packed);
+        PutU32(item + 12,I.entry[k].raw);
+        fwrite(item,1,16,out);
+    }
+    PutU64(trailer,I.count);
+    PutU64(trailer + 8,I.total);
+    PutU64(trailer + 16,offset);
+    memcpy(trailer + 24,"HUFB",4);
+    fwrite(trailer,1,TRAILER_BYTES,out);
+    *total = I.total;
+    if(ferror(in) || ferror(out)) status = ERROR;
+    free(raw);
+    free(packed);
+    free(I.entry);
+    fclose(in);
+    if(fclose(out) != 0) status = ERROR;
+    return status;
+}
+
+/* 解压 ********************************************** */
+//读文件尾部和块索引。各块必须从文件头之后首尾相接排到索引之前，除最后一块外原长都等于块大小
+Status ReadBlockIndex(FILE *fp,BlockIndex *I) {
+    uint8_t head[8],trailer[TRAILER_BYTES],item[16];
+    memset(I,0,sizeof(BlockIndex));
+    if(fseek(fp,0,SEEK_SET) != 0 || fread(head,1,8,fp) != 8 || memcmp(head,"HUFB",4) != 0) return ERROR;
+    I->blockSize = GetU32(head + 4);
+    if(I->blockSize == 0 || I->blockSize > MAX_BLOCK) return ERROR;
+    if(fseek(fp,-TRAILER_BYTES,SEEK_END) != 0 || fread(trailer,1,TRAILER_BYTES,fp) != TRAILER_BYTES ||
+       memcmp(trailer + 24,"HUFB",4) != 0) {
+        return ERROR;
+    }
+    uint64_t count = GetU64(trailer),indexOffset = GetU64(trailer + 16);
+    if(fseek(fp,(long)indexOffset,SEEK_SET) != 0) return ERROR;
+    uint64_t next = 8;
+    for(uint64_t k = 0;k < count;k++) {
+        if(fread(item,1,16,fp) != 16) return ERROR;
+        uint64_t offset = GetU64(item);
+        uint32_t packed = GetU32(item + 8),raw = GetU32(item + 12);
+        if(offset != next || raw > I->blockSize || (k + 1 < count && raw != I->blockSize) ||
+           offset + packed > indexOffset || !AddEntry(I,offset,packed,raw)) {
+            return ERROR;
+        }
+        next = offset + packed;
+    }
+    return next == indexOffset && I->total == GetU64(trailer + 8) ? OK : ERROR;
+}
+//随机访问：只解出第k块，out至少blockSize字节，返回该块原长，失败返回-1
+long ReadBlock(FILE *fp,const BlockIndex *I,uint64_t k,uint8_t *out) {
+    if(k >= I->count) return -1;
+    const BlockEntry *e = &I->entry[k];
+    uint8_t *packed = (uint8_t*)malloc(e->packed > 0 ? e->packed : 1);
+    long result = -1;
+    if(packed && fseek(fp,(long)e->offset,SEEK_SET) == 0 && fread(packed,1,e->packed,fp) == e->packed &&
+       DecodeBlock(packed,e->packed,out,e->raw)) {
+        result = e->raw;
+    }
+    free(packed);
+    return result;
+}
+//按批读入相邻的块，并行解码后顺序写出
+Status DecompressFile(const char *inPath,const char *outPath,uint64_t *total) {
+    FILE *in = fopen(inPath,"rb");
+    if(!in) return ERROR;
+    BlockIndex I;
+    if(ReadBlockIndex(in,&I) != OK) {
+        printf("%s: not a HUFB file\n",inPath);
+        free(I.entry);
+        fclose(in);
+        return ERROR;
+    }
+    FILE *out = fopen(outPath,"wb");
+    if(!out) {
+        free(I.entry);
+        fclose(in);
+        return ERROR;
+    }
+    size_t packedCapacity = HUFF_HEADER_BYTES + (size_t)I.blockSize / 8 * HUFF_MAX_LEN + 16;
+    uint8_t *packed = (uint8_t*)malloc(packedCapacity * BATCH);
+    uint8_t *raw = (uint8_t*)malloc((size_t)I.blockSize * BATCH);
+    Status status = packed && raw ? OK : ERROR;
+    for(uint64_t first = 0;status == OK && first < I.count;first += BATCH) {
+        int blocks = I.count - first < BATCH ? (int)(I.count - first) : BATCH;
+        //一批块在文件中是连续的
+        const BlockEntry *e = I.entry + first;
+        size_t bytes = (size_t)(e[blocks - 1].offset + e[blocks - 1].packed - e[0].offset);
+        if(bytes > packedCapacity * BATCH || fseek(in,(long)e[0].offset,SEEK_SET) != 0 ||
+           fread(packed,1,bytes,in) != bytes) {
+            status = ERROR;
+            break;
+        }
+        int bad = 0;
+        #pragma omp parallel for schedule(dynamic,1) reduction(+:bad)
+        for(int b = 0;b < blocks;b++) {
+            bad += !DecodeBlock(packed + (e[b].offset - e[0].offset),e[b].packed,raw + (size_t)b * I.blockSize,e[b].raw);
+        }
+        if(bad) {
+            printf("%s: corrupted block\n",inPath);
+            status = ERROR;
+            break;
+        }
+        for(int b = 0;b < blocks;b++) fwrite(raw + (size_t)b * I.blockSize,1,e[b].raw,out);
+    }
+    *total = I.total;
+    if(ferror(out)) status = ERROR;
+    free(packed);
+    free(raw);
+    free(I.entry);
+    fclose(in);
+    if(fclose(out) != 0) status = ERROR;
+    return status;
+}
+
+/* 演示 ********************************************** */
+//文本为主、夹杂一段随机数据(不可压缩，走原样存储)的样例文件
+void WriteDemoFile(const char *path,long bytes) {
+    const char *words[] = {"GET","POST","/index.html","/api/v1/items","200","404","500","user","session",
+                           "timeout","cache","hit","miss","ms","bytes","INFO","WARN","ERROR","DEBUG"};
+    int numWords = sizeof(words) / sizeof(words[0]);
+    FILE *fp = fopen(path,"wb");
+    char line[256];
+    long written = 0,lineNo = 0;
+    while(written < bytes) {
+        int len = 0;
+        if(written > bytes / 2 && written < bytes / 2 + 3 * BLOCK) {
+            for(len = 0;len < 200;len++) line[len] = (char)rand();
+        } else {
+            len = sprintf(line,"%ld",lineNo++);
+            for(int k = 0;k < 8;k++) len += sprintf(line + len," %s",words[rand() % numWords]);
+            line[len++] = '\n';
+        }
+        fwrite(line,1,len,fp);
+        written += len;
+    }
+    fclose(fp);
+}
+
+long FileSize(const char *path) {
+    FILE *fp = fopen(path,"rb");
+    if(!fp) return -1;
+    fseek(fp,0,SEEK_END);
+    long size = ftell(fp);
+    fclose(fp);
+    return size;
+}
+
+int SameFile(const char *a,const char *b) {
+    FILE *fa = fopen(a,"rb"),*fb = fopen(b,"rb");
+    int same = fa && fb;
+    uint8_t *x = (uint8_t*)malloc(BLOCK),*y = (uint8_t*)malloc(BLOCK);
+    while(same) {
+        size_t n = fread(x,1,BLOCK,fa),m = fread(y,1,BLOCK,fb);
+        if(n != m || memcmp(x,y,n) != 0) same = 0;
+        if(n == 0) break;
+    }
+    free(x);
+    free(y);
+    if(fa) fclose(fa);
+    if(fb) fclose(fb);
+    return same;
+}
+
+int main(int argc,char *argv[]) {
+    uint64_t total;
+    if(argc == 4) {
+        Status status = argv[1][0] == 'c' ? CompressFile(argv[2],argv[3],&total) : DecompressFile(argv[2],argv[3],&total);
+        if(status != OK) printf("Failed\n");
+        return status == OK ? 0 : 1;
+    }
+    const char *text = "huffman_block_demo.log",*packed = "huffman_block_demo.hufb",*restored = "huffman_block_demo.out";
+    srand(2024);
+    WriteDemoFile(text,200L << 20);
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    double begin = Now();
+    if(CompressFile(text,packed,&total) != OK) {
+        printf("Compress failed\n");
+        return 1;
+    }
+    double encodeTime = Now() - begin;
+    begin = Now();
+    if(DecompressFile(packed,restored,&total) != OK) {
+        printf("Decompress failed\n");
+        return 1;
+    }
+    double decodeTime = Now() - begin;
+    double mb = total / 1048576.0;
+    printf("%d threads, input %.1f MB in %.0f blocks, compressed %ld bytes (%.1f%%)\n",threads,mb,
+           (double)((total + BLOCK - 1) / BLOCK),FileSize(packed),100.0 * FileSize(packed) / total);
+    printf("Compress   %.3fs %.0f MB/s\n",encodeTime,mb / encodeTime);
+    printf("Decompress %.3fs %.0f MB/s\n",decodeTime,mb / decodeTime);
+    printf("Round trip %s\n",SameFile(text,restored) ? "OK" : "MISMATCH");
+    //随机访问若干块，与原文件对应位置比较
+    FILE *fp = fopen(packed,"rb"),*orig = fopen(text,"rb");
+    BlockIndex I;
+    uint8_t *block = (uint8_t*)malloc(BLOCK),*expect = (uint8_t*)malloc(BLOCK);
+    int wrong = 0,samples = 20;
+    if(ReadBlockIndex(fp,&I) == OK) {
+        begin = Now();
+        for(int i = 0;i < samples;i++) {
+            uint64_t k = (uint64_t)rand() % I.count;
+            long n = ReadBlock(fp,&I,k,block);
+            fseek(orig,(long)(k * I.blockSize),SEEK_SET);
+            if(n < 0 || fread(expect,1,n,orig) != (size_t)n || memcmp(block,expect,n) != 0) wrong++;
+        }
+        printf("Random access %d blocks avg %.3fms wrong %d\n",samples,(Now() - begin) * 1000 / samples,wrong);
+    }
+    free(I.entry);
+    free(block);
+    free(expect);
+    fclose(fp);
+    fclose(orig);
+    remove(text);
+    remove(packed);
+    remove(restored);
+    return 0;
+}
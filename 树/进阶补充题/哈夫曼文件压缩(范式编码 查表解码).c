@@ -0,0 +1,211 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "../Huffman.h"
+/*
+哈夫曼文件压缩与解压
+哈夫曼树.c只统计字母，编码结果是'0''1'字符串，解码逐位走树
+这里对任意文件按字节压缩，编码、码长、位读写见 ../Huffman.h
+文件格式：
+  "HUF1" | 原长度(8字节小端) | 256个码长(每个4位，128字节) | 码流(低位先写，末尾补0)
+压缩读两遍文件：第一遍统计频率，第二遍按块编码写出；解压按块解码写出，内存只占两个块
+用法：哈夫曼文件压缩 c 输入 输出 / 哈夫曼文件压缩 d 输入 输出，不带参数时跑演示
+分块独立编码、可并行和随机访问的版本见 哈夫曼分块并行压缩(OpenMP 块索引).c
+*/
+#define OK 1
+#define ERROR 0
+#define CHUNK (1 << 20)
+
+typedef int Status;
+
+void PutU64(uint8_t *p,uint64_t x) {
+    for(int i = 0;i < 8;i++) p[i] = (uint8_t)(x >> (8 * i));
+}
+
+uint64_t GetU64(const uint8_t *p) {
+    uint64_t x = 0;
+    for(int i = 0;i < 8;i++) x |= (uint64_t)p[i] << (8 * i);
+    return x;
+}
+//压缩，成功时total为原文件字节数
+Status CompressFile(const char *inPath,const char *outPath,uint64_t *total) {
+    FILE *in = fopen(inPath,"rb");
+    if(!in) return ERROR;
+    FILE *out = fopen(outPath,"wb");
+    if(!out) {
+        fclose(in);
+        return ERROR;
+    }
+    uint8_t *chunk = (uint8_t*)malloc(CHUNK);
+    uint8_t *code = (uint8_t*)malloc(CHUNK / 8 * HUFF_MAX_LEN + 16);
+    if(!chunk || !code) {
+        free(chunk);
+        free(code);
+        fclose(in);
+        fclose(out);
+        return ERROR;
+    }
+    uint64_t freq[HUFF_SYMBOLS] = {0};
+    size_t n;
+    *total = 0;
+    //第一遍：统计频率
+    while((n = fread(chunk,1,CHUNK,in)) > 0) {
+        for(size_t i = 0;i < n;i++) freq[chunk[i]]++;
+        *total += n;
+    }
+    uint8_t length[HUFF_SYMBOLS],header[4 + 8 + HUFF_HEADER_BYTES];
+    HuffmanLengths(freq,length);
+    HuffEncoder E;
+    InitEncoder(&E,length);
+    memcpy(header,"HUF1",4);
+    PutU64(header + 4,*total);
+    PackLengths(length,header + 12);
+    fwrite(header,1,sizeof(header),out);
+    //第二遍：编码
+    rewind(in);
+    BitWriter W;
+    InitBitWriter(&W,code);
+    while((n = fread(chunk,1,CHUNK,in)) > 0) {
+        HuffmanEncode(&E,&W,chunk,n);
+        fwrite(code,1,W.pos,out);
+        W.pos = 0;
+    }
+    FlushBitWriter(&W,1);
+    fwrite(code,1,W.pos,out);
+    Status status = ferror(in) || ferror(out) ? ERROR : OK;
+    free(chunk);
+    free(code);
+    fclose(in);
+    if(fclose(out) != 0) status = ERROR;
+    return status;
+}
+
+Status DecompressFile(const char *inPath,const char *outPath,uint64_t *total) {
+    FILE *in = fopen(inPath,"rb");
+    if(!in) return ERROR;
+    uint8_t header[4 + 8 + HUFF_HEADER_BYTES],length[HUFF_SYMBOLS];
+    HuffDecoder D;
+    if(fread(header,1,sizeof(header),in) != sizeof(header) || memcmp(header,"HUF1",4) != 0) {
+        printf("%s: not a HUF1 file\n",inPath);
+        fclose(in);
+        return ERROR;
+    }
+    *total = GetU64(header + 4);
+    UnpackLengths(header + 12,length);
+    if(!InitDecoder(&D,length)) {
+        printf("%s: invalid code lengths\n",inPath);
+        fclose(in);
+        return ERROR;
+    }
+    FILE *out = fopen(outPath,"wb");
+    if(!out) {
+        fclose(in);
+        return ERROR;
+    }
+    BitReader R;
+    uint8_t *chunk = (uint8_t*)malloc(CHUNK);
+    Status status = InitFileBitReader(&R,in,CHUNK) && chunk ? OK : ERROR;
+    for(uint64_t done = 0;status == OK && done < *total;) {
+        size_t n = *total - done < CHUNK ? (size_t)(*total - done) : CHUNK;
+        if(!HuffmanDecode(&D,&R,chunk,n)) {
+            printf("%s: corrupted data\n",inPath);
+            status = ERROR;
+            break;
+        }
+        fwrite(chunk,1,n,out);
+        done += n;
+    }
+    if(ferror(out)) status = ERROR;
+    FreeBitReader(&R);
+    free(chunk);
+    fclose(in);
+    if(fclose(out) != 0) status = ERROR;
+    return status;
+}
+
+long FileSize(const char *path) {
+    FILE *fp = fopen(path,"rb");
+    if(!fp) return -1;
+    fseek(fp,0,SEEK_END);
+    long size = ftell(fp);
+    fclose(fp);
+    return size;
+}
+//逐块比较两个文件
+int SameFile(const char *a,const char *b) {
+    FILE *fa = fopen(a,"rb"),*fb = fopen(b,"rb");
+    int same = fa && fb;
+    uint8_t *x = (uint8_t*)malloc(CHUNK),*y = (uint8_t*)malloc(CHUNK);
+    while(same) {
+        size_t n = fread(x,1,CHUNK,fa),m = fread(y,1,CHUNK,fb);
+        if(n != m || memcmp(x,y,n) != 0) same = 0;
+        if(n == 0) break;
+    }
+    free(x);
+    free(y);
+    if(fa) fclose(fa);
+    if(fb) fclose(fb);
+    return same;
+}
+//演示数据：按Zipf分布抽单词拼成的英文样文本
+void WriteDemoText(const char *path,long bytes) {
+    const char *words[] = {"the","of","and","to","in","a","is","that","for","it","as","was","with","be","by",
+                           "on","not","he","tree","huffman","code","node","frequency","binary","left","right",
+                           "weight","path","length","compress","table","symbol","stream","buffer","decode"};
+    int numWords = sizeof(words) / sizeof(words[0]);
+    FILE *fp = fopen(path,"wb");
+    char line[128];
+    long written = 0;
+    while(written < bytes) {
+        int len = 0;
+        while(len < 70) {
+            //P(第k个词)约为1/k
+            int k = (int)(numWords * pow((double)rand() / RAND_MAX,3.0));
+            if(k >= numWords) k = numWords - 1;
+            len += sprintf(line + len,"%s%s",len ? " " : "",words[k]);
+        }
+        line[len++] = rand() % 8 ? '\n' : '.';
+        fwrite(line,1,len,fp);
+        written += len;
+    }
+    fclose(fp);
+}
+
+double Elapsed(clock_t begin) {
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+int main(int argc,char *argv[]) {
+    uint64_t total;
+    if(argc == 4) {
+        Status status = argv[1][0] == 'c' ? CompressFile(argv[2],argv[3],&total) : DecompressFile(argv[2],argv[3],&total);
+        if(status != OK) printf("Failed\n");
+        return status == OK ? 0 : 1;
+    }
+    const char *text = "huffman_demo.txt",*packed = "huffman_demo.huf",*restored = "huffman_demo.out";
+    srand(2024);
+    WriteDemoText(text,64L << 20);
+    clock_t begin = clock();
+    if(CompressFile(text,packed,&total) != OK) {
+        printf("Compress failed\n");
+        return 1;
+    }
+    double encodeTime = Elapsed(begin);
+    begin = clock();
+    if(DecompressFile(packed,restored,&total) != OK) {
+        printf("Decompress failed\n");
+        return 1;
+    }
+    double decodeTime = Elapsed(begin);
+    double mb = total / 1048576.0;
+    printf("Input %.1f MB, compressed %ld bytes (%.1f%%)\n",mb,FileSize(packed),100.0 * FileSize(packed) / total);
+    printf("Compress   %.3fs %.0f MB/s\n",encodeTime,mb / encodeTime);
+    printf("Decompress %.3fs %.0f MB/s\n",decodeTime,mb / decodeTime);
+    printf("Round trip %s\n",SameFile(text,restored) ? "OK" : "MISMATCH");
+    remove(text);
+    remove(packed);
+    remove(restored);
+    return 0;
+}
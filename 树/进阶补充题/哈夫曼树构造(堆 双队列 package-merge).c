@@ -0,0 +1,144 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../Huffman.h"
+/*
+大字母表的哈夫曼树构造
+哈夫曼树.c的Create每合并一次就调用lengths和SelectMin各扫一遍node[]，共O(n^2)，且每个结点malloc一次
+字母表是字或16位符号时n可达几十万，这里对比(建树函数见 ../Huffman.h)：
+1 线性扫描：同Create的做法，只是结点放在数组池里
+2 堆：O(n log n)
+3 双队列：频率已排好序时O(n)，未排序时加一次排序
+4 package-merge：码长不超过L的最优码，L取解码表位数时查表解码的表大小有界
+各方法的WPL(带权路径长度)应相同，限长码的WPL不小于最优，差多少即为限长的代价
+*/
+//同哈夫曼树.c的SelectMin：每次扫描全部未合并结点找最小的两个
+int BuildScanTree(HuffArena *A,const uint64_t *freq,int n) {
+    int *alive = (int*)malloc(sizeof(int) * (n > 0 ? n : 1)),count = 0;
+    for(int s = 0;s < n;s++) {
+        A->weight[s] = freq[s];
+        if(freq[s]) alive[count++] = s;
+    }
+    while(count > 1) {
+        int min1 = -1,min2 = -1;
+        for(int i = 0;i < count;i++) {
+            if(min1 == -1 || A->weight[alive[i]] < A->weight[alive[min1]]) {
+                min2 = min1;
+                min1 = i;
+            } else if(min2 == -1 || A->weight[alive[i]] < A->weight[alive[min2]]) {
+                min2 = i;
+            }
+        }
+        int v = NewInternal(A,alive[min1],alive[min2]);
+        //合并结点放在min2处，min1处由最后一个补上
+        alive[min2] = v;
+        alive[min1] = alive[--count];
+    }
+    int root = count ? alive[0] : -1;
+    free(alive);
+    return root;
+}
+//带权路径长度
+uint64_t WPL(const uint64_t *freq,const int *length,int n) {
+    uint64_t total = 0;
+    for(int s = 0;s < n;s++) total += freq[s] * (uint64_t)length[s];
+    return total;
+}
+//Kraft和是否恰为1(完全前缀码)且码长不超过maxLen
+int ValidLengths(const int *length,int n,int maxLen) {
+    double kraft = 0;
+    int used = 0;
+    for(int s = 0;s < n;s++) {
+        if(length[s] == 0) continue;
+        if(length[s] > maxLen) return 0;
+        kraft += 1.0 / (double)(1ULL << length[s]);
+        used++;
+    }
+    return used <= 1 || (kraft > 1 - 1e-9 && kraft < 1 + 1e-9);
+}
+//Zipf分布的频率：第s个符号约为 total/(s+1)，模拟按字编码时的词频
+void ZipfFrequency(uint64_t *freq,int n) {
+    for(int s = 0;s < n;s++) {
+        freq[s] = 100000000ULL / (s + 1) + rand() % 3;
+    }
+    //打乱顺序
+    for(int s = n - 1;s > 0;s--) {
+        int j = ((unsigned)rand() * 32768u + rand()) % (s + 1);
+        uint64_t tmp = freq[s];
+        freq[s] = freq[j];
+        freq[j] = tmp;
+    }
+}
+
+double Elapsed(clock_t begin) {
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    //小例子：哈夫曼树.c中的"ABAADCBC"
+    uint64_t small[4] = {3,2,2,1}; // A B C D
+    int length[4];
+    HuffArena A;
+    InitArena(&A,4);
+    TreeLengths(&A,BuildHeapTree(&A,small,4),4,length);
+    printf("ABAADCBC lengths A=%d B=%d C=%d D=%d WPL = %llu\n",length[0],length[1],length[2],length[3],
+           (unsigned long long)WPL(small,length,4));
+    FreeArena(&A);
+
+    printf("\n*******\n");
+    srand(2024);
+    int sizes[] = {1000,20000,200000,1000000};
+    for(int k = 0;k < 4;k++) {
+        int n = sizes[k];
+        uint64_t *freq = (uint64_t*)malloc(sizeof(uint64_t) * n);
+        int *len = (int*)malloc(sizeof(int) * n),*order = (int*)malloc(sizeof(int) * n);
+        ZipfFrequency(freq,n);
+        printf("n=%d\n",n);
+        //线性扫描只跑小规模
+        uint64_t best = 0;
+        if(n <= 20000) {
+            clock_t begin = clock();
+            InitArena(&A,n);
+            int maxLen = TreeLengths(&A,BuildScanTree(&A,freq,n),n,len);
+            FreeArena(&A);
+            best = WPL(freq,len,n);
+            printf("  Scan       %8.3fms maxLen %2d WPL %llu\n",Elapsed(begin) * 1000,maxLen,(unsigned long long)best);
+        }
+        clock_t begin = clock();
+        InitArena(&A,n);
+        int maxLen = TreeLengths(&A,BuildHeapTree(&A,freq,n),n,len);
+        FreeArena(&A);
+        uint64_t heapWPL = WPL(freq,len,n);
+        if(best == 0) best = heapWPL;
+        printf("  Heap       %8.3fms maxLen %2d WPL %llu %s\n",Elapsed(begin) * 1000,maxLen,
+               (unsigned long long)heapWPL,heapWPL == best ? "OK" : "DIFF");
+        begin = clock();
+        int m = SortByFrequency(freq,n,order);
+        double sortTime = Elapsed(begin);
+        begin = clock();
+        InitArena(&A,n);
+        maxLen = TreeLengths(&A,BuildTwoQueueTree(&A,freq,order,m),n,len);
+        FreeArena(&A);
+        uint64_t queueWPL = WPL(freq,len,n);
+        printf("  TwoQueue   %8.3fms (+%.3fms sort) maxLen %2d WPL %llu %s\n",Elapsed(begin) * 1000,sortTime * 1000,
+               maxLen,(unsigned long long)queueWPL,queueWPL == best ? "OK" : "DIFF");
+        //限长
+        int limits[] = {maxLen - 1,maxLen - 2,HUFF_MAX_LEN};
+        for(int i = 0;i < 3;i++) {
+            int L = limits[i];
+            begin = clock();
+            if(!PackageMerge(freq,n,L,len)) {
+                printf("  PackMerge L=%2d impossible, more than 2^L symbols\n",L);
+                continue;
+            }
+            uint64_t limited = WPL(freq,len,n);
+            printf("  PackMerge L=%2d %8.3fms WPL %llu (+%.4f%%) %s\n",L,Elapsed(begin) * 1000,(unsigned long long)limited,
+                   100.0 * (limited - best) / best,ValidLengths(len,n,L) && limited >= best ? "OK" : "INVALID");
+        }
+        free(freq);
+        free(len);
+        free(order);
+    }
+    return 0;
+}
@@ -0,0 +1,467 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*
+层序遍历引擎
+链表二叉树.c的GetLayer/GetLayNum、森林-树-孩子兄弟表示法.c的GetLayer/GetLayerForest/HeightUpdate
+用的都是MAXSIZES 100的循环队列，Add满了返回ERROR没人检查，宽一点的树结点就丢了
+这里：
+1 队列是容量为2的幂的环形缓冲区，head/tail只增不减，下标&(capacity-1)，满了翻倍并把内容摆正
+  队列由调用者持有，多次遍历复用同一块内存
+2 孩子通过TreeOps取得(firstChild/nextChild)，二叉树和孩子兄弟树用同一套引擎，多个根即森林
+3 每层开始时把整层交给LevelVisitor(层号从1开始，与GetLayNum相同)，可以算层宽、层和、右视图，
+  或者找到目标后返回0提前结束；NodeVisitor逐个访问结点，返回0同样结束
+  层中第k个结点用SpanAt取，环形队列里的一层可能绕回开头
+4 并行模式按层推进：当前层、下一层各是一个数组，层宽超过PARALLEL_MIN时按线程切块，
+  先数每块的孩子数，前缀和得到写入位置，再各自写入，下一层的顺序与串行相同
+  编译时不加-fopenmp则退化为单线程
+*/
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#define OK 1
+#define ERROR 0
+#define PARALLEL_MIN 65536
+
+typedef int Status;
+
+typedef struct {
+    void *(*firstChild)(void *node);
+    void *(*nextChild)(void *node,void *child); // child之后的下一个孩子
+} TreeOps;
+
+typedef struct {
+    void **data;
+    unsigned capacity; // 2的幂
+    unsigned head,tail; // 长度为tail-head
+} NodeRing;
+
+typedef struct {
+    void **data;
+    unsigned start,mask; // 数组时mask为全1
+    int width;
+} LevelSpan;
+
+typedef int (*NodeVisitor)(void *node,void *arg);
+typedef int (*LevelVisitor)(int level,const LevelSpan *S,void *arg);
+
+/* 环形队列 ***************************************** */
+Status InitRing(NodeRing *Q,unsigned capacity) {
+    Q->capacity = 16;
+    while(Q->capacity < capacity) Q->capacity *= 2;
+    Q->data = (void**)malloc(sizeof(void*) * Q->capacity);
+    Q->head = Q->tail = 0;
+    return Q->data != NULL;
+}
+
+void DestroyRing(NodeRing *Q) {
+    free(Q->data);
+    Q->data = NULL;
+    Q->capacity = Q->head = Q->tail = 0;
+}
+
+unsigned RingLength(const NodeRing *Q) {
+    return Q->tail - Q->head;
+}
+
+Status RingPush(NodeRing *Q,void *E) {
+    if(Q->tail - Q->head == Q->capacity) {
+        if(Q->capacity >= 1u << 31) return ERROR;
+        void **grown = (void**)malloc(sizeof(void*) * Q->capacity * 2);
+        if(!grown) return ERROR;
+        //从head开始的两段依次搬到新数组开头
+        unsigned mask = Q->capacity - 1,h = Q->head & mask;
+        memcpy(grown,Q->data + h,sizeof(void*) * (Q->capacity - h));
+        memcpy(grown + (Q->capacity - h),Q->data,sizeof(void*) * h);
+        free(Q->data);
+        Q->data = grown;
+        Q->head = 0;
+        Q->tail = Q->capacity;
+        Q->capacity *= 2;
+    }
+    Q->data[Q->tail++ & (Q->capacity - 1)] = E;
+    return OK;
+}
+
+void *RingPop(NodeRing *Q) {
+    return Q->data[Q->head++ & (Q->capacity - 1)];
+}
+
+void *SpanAt(const LevelSpan *S,int k) {
+    return S->data[(S->start + (unsigned)k) & S->mask];
+}
+
+/* 串行引擎 ***************************************** */
+//返回走过的层数(走完时即高度)，内存不足返回-1
+int LevelOrder(NodeRing *Q,void **roots,int numRoots,const TreeOps *ops,NodeVisitor visitNode,
+               LevelVisitor visitLevel,void *arg) {
+    Q->head = Q->tail = 0;
+    for(int i = 0;i < numRoots;i++) {
+        if(roots[i] && !RingPush(Q,roots[i])) return -1;
+    }
+    int level = 0;
+    while(RingLength(Q)) {
+        int width = (int)RingLength(Q);
+        level++;
+        if(visitLevel) {
+            LevelSpan S = {Q->data,Q->head,Q->capacity - 1,width};
+            if(!visitLevel(level,&S,arg)) return level;
+        }
+        for(int k = 0;k < width;k++) {
+            void *E = RingPop(Q);
+            if(visitNode && !visitNode(E,arg)) return level;
+            for(void *c = ops->firstChild(E);c;c = ops->nextChild(E,c)) {
+                if(!RingPush(Q,c)) return -1;
+            }
+        }
+    }
+    return level;
+}
+
+/* 并行引擎 ***************************************** */
+typedef struct {
+    void **data;
+    long long count,capacity;
+} NodeList;
+
+Status ReserveList(NodeList *L,long long capacity) {
+    if(capacity <= L->capacity) return OK;
+    void **grown = (void**)realloc(L->data,sizeof(void*) * capacity);
+    if(!grown) return ERROR;
+    L->data = grown;
+    L->capacity = capacity;
+    return OK;
+}
+//把cur的孩子按顺序写入next
+Status ExpandLevel(const NodeList *cur,NodeList *next,const TreeOps *ops) {
+    int threads = 1;
+#ifdef _OPENMP
+    if(cur->count >= PARALLEL_MIN) threads = omp_get_max_threads();
+#endif
+    //实际线程数可能少于请求的(OMP_DYNAMIC、线程数上限)，offset按请求数开，切分按进入并行区后的实际数
+    long long *offset = (long long*)calloc(threads + 1,sizeof(long long));
+    if(!offset) return ERROR;
+    int ok = 1,team = 1;
+    #pragma omp parallel num_threads(threads)
+    {
+        int t = 0;
+#ifdef _OPENMP
+        t = omp_get_thread_num();
+        #pragma omp single
+        team = omp_get_num_threads();
+#endif
+        long long begin = cur->count * t / team,end = cur->count * (t + 1) / team,count = 0;
+        for(long long i = begin;i < end;i++) {
+            for(void *c = ops->firstChild(cur->data[i]);c;c = ops->nextChild(cur->data[i],c)) count++;
+        }
+        offset[t + 1] = count;
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for(int k = 0;k < team;k++) offset[k + 1] += offset[k];
+            next->count = 0;
+            ok = ReserveList(next,offset[team]);
+        }
+        if(ok) {
+            long long k = offset[t];
+            for(long long i = begin;i < end;i++) {
+                for(void *c = ops->firstChild(cur->data[i]);c;c = ops->nextChild(cur->data[i],c)) next->data[k++] = c;
+            }
+        }
+    }
+    if(ok) next->count = offset[team];
+    free(offset);
+    return ok;
+}
+//同LevelOrder，但没有逐个结点的访问者(同一层的结点由多个线程同时展开)
+int LevelOrderParallel(void **roots,int numRoots,const TreeOps *ops,LevelVisitor visitLevel,void *arg) {
+    NodeList cur = {NULL,0,0},next = {NULL,0,0};
+    int level = 0;
+    if(!ReserveList(&cur,numRoots > 0 ? numRoots : 1)) return -1;
+    for(int i = 0;i < numRoots;i++) {
+        if(roots[i]) cur.data[cur.count++] = roots[i];
+    }
+    while(cur.count) {
+        level++;
+        LevelSpan S = {cur.data,0,~0u,(int)cur.count};
+        if(visitLevel && !visitLevel(level,&S,arg)) break;
+        if(!ExpandLevel(&cur,&next,ops)) {
+            level = -1;
+            break;
+        }
+        NodeList tmp = cur;
+        cur = next;
+        next = tmp;
+    }
+    free(cur.data);
+    free(next.data);
+    return level;
+}
+
+/* 两种树的TreeOps ********************************** */
+//链表二叉树.c
+typedef struct TreeNode {
+    char data;
+    struct TreeNode *leftChild,*rightChild;
+} TreeNode,*Tree;
+
+void *BinaryFirst(void *node) {
+    Tree T = (Tree)node;
+    return T->leftChild ? T->leftChild : T->rightChild;
+}
+
+void *BinaryNext(void *node,void *child) {
+    Tree T = (Tree)node;
+    return child == T->leftChild ? T->rightChild : NULL;
+}
+
+const TreeOps binaryOps = {BinaryFirst,BinaryNext};
+//森林-树-孩子兄弟表示法.c
+typedef struct CSNode {
+    char data;
+    struct CSNode *firstSon,*nextBrother;
+} CSNode,*CSTree;
+
+void *SiblingFirst(void *node) {
+    return ((CSTree)node)->firstSon;
+}
+
+void *SiblingNext(void *node,void *child) {
+    (void)node;
+    return ((CSTree)child)->nextBrother;
+}
+
+const TreeOps siblingOps = {SiblingFirst,SiblingNext};
+
+/* 访问者 ******************************************* */
+//二叉树和孩子兄弟树的结点都以data开头
+char NodeData(void *node) {
+    return *(char*)node;
+}
+
+int PrintNode(void *node,void *arg) {
+    (void)arg;
+    printf("%c",NodeData(node));
+    return 1;
+}
+
+typedef struct {
+    char target;
+    int level; // 没找到为-1
+} FindArg;
+//同GetLayNum
+int FindLevel(int level,const LevelSpan *S,void *arg) {
+    FindArg *a = (FindArg*)arg;
+    for(int k = 0;k < S->width;k++) {
+        if(NodeData(SpanAt(S,k)) == a->target) {
+            a->level = level;
+            return 0;
+        }
+    }
+    return 1;
+}
+//每层的宽度、data之和、最右结点(右视图)
+typedef struct {
+    int maxLevels;
+    int levels;
+    int *width;
+    long long *sum;
+    char *right;
+} LevelStats;
+
+int CollectStats(int level,const LevelSpan *S,void *arg) {
+    LevelStats *a = (LevelStats*)arg;
+    a->levels = level;
+    if(level > a->maxLevels) return 1;
+    long long sum = 0;
+    for(int k = 0;k < S->width;k++) sum += (unsigned char)NodeData(SpanAt(S,k));
+    a->width[level - 1] = S->width;
+    a->sum[level - 1] = sum;
+    a->right[level - 1] = NodeData(SpanAt(S,S->width - 1));
+    return 1;
+}
+
+Status InitStats(LevelStats *a,int maxLevels) {
+    a->maxLevels = maxLevels;
+    a->levels = 0;
+    a->width = (int*)calloc(maxLevels,sizeof(int));
+    a->sum = (long long*)calloc(maxLevels,sizeof(long long));
+    a->right = (char*)calloc(maxLevels + 1,1);
+    return a->width && a->sum && a->right;
+}
+
+void FreeStats(LevelStats *a) {
+    free(a->width);
+    free(a->sum);
+    free(a->right);
+}
+
+int SameStats(const LevelStats *a,const LevelStats *b) {
+    if(a->levels != b->levels) return 0;
+    int n = a->levels < a->maxLevels ? a->levels : a->maxLevels;
+    return memcmp(a->width,b->width,sizeof(int) * n) == 0 && memcmp(a->sum,b->sum,sizeof(long long) * n) == 0 &&
+           memcmp(a->right,b->right,n) == 0;
+}
+
+/* 演示 ********************************************* */
+//同 下标二叉树(连续结点池).c 的CreateLinkedTree
+Tree CreateLinkedTree(const char *chars,int length) {
+    Tree root = NULL;
+    Tree **slot = (Tree**)malloc(sizeof(Tree*) * (length + 1));
+    int top = 0;
+    slot[top++] = &root;
+    for(int i = 0;top && i < length;i++) {
+        Tree *s = slot[--top];
+        if(chars[i] == '#') {
+            *s = NULL;
+        } else {
+            *s = (Tree)malloc(sizeof(TreeNode));
+            (*s)->data = chars[i];
+            slot[top++] = &(*s)->rightChild;
+            slot[top++] = &(*s)->leftChild;
+        }
+    }
+    free(slot);
+    return root;
+}
+
+//同CreateTree：前序串，firstSon相当于左孩子、nextBrother相当于右孩子
+CSTree CreateSiblingTree(const char *chars) {
+    CSTree root = NULL;
+    int length = (int)strlen(chars),top = 0;
+    CSTree **slot = (CSTree**)malloc(sizeof(CSTree*) * (length + 1));
+    slot[top++] = &root;
+    for(int i = 0;top && i < length;i++) {
+        CSTree *s = slot[--top];
+        if(chars[i] == '#') {
+            *s = NULL;
+        } else {
+            *s = (CSTree)malloc(sizeof(CSNode));
+            (*s)->data = chars[i];
+            slot[top++] = &(*s)->nextBrother;
+            slot[top++] = &(*s)->firstSon;
+        }
+    }
+    free(slot);
+    return root;
+}
+//层序释放：先把孩子入队再释放结点
+void FreeAll(NodeRing *Q,void **roots,int numRoots,const TreeOps *ops) {
+    Q->head = Q->tail = 0;
+    for(int i = 0;i < numRoots;i++) if(roots[i]) RingPush(Q,roots[i]);
+    while(RingLength(Q)) {
+        void *E = RingPop(Q);
+        for(void *c = ops->firstChild(E);c;c = ops->nextChild(E,c)) RingPush(Q,c);
+        free(E);
+    }
+}
+
+unsigned Rand32() {
+    return (unsigned)rand() * 32768u + rand();
+}
+
+double Now() {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+//结点从一个数组里按随机顺序取，模拟散落在堆上
+void *ScatteredPool(size_t size,long long n,long long **order) {
+    char *pool = (char*)malloc(size * n);
+    *order = (long long*)malloc(sizeof(long long) * n);
+    for(long long i = 0;i < n;i++) (*order)[i] = i;
+    for(long long i = n - 1;i > 0;i--) {
+        long long j = (long long)(Rand32() % (unsigned)(i + 1)),tmp = (*order)[i];
+        (*order)[i] = (*order)[j];
+        (*order)[j] = tmp;
+    }
+    return pool;
+}
+
+void Benchmark(const char *name,NodeRing *Q,void **roots,int numRoots,const TreeOps *ops) {
+    LevelStats a,b;
+    InitStats(&a,64);
+    InitStats(&b,64);
+    double begin = Now();
+    int h1 = LevelOrder(Q,roots,numRoots,ops,NULL,CollectStats,&a);
+    double ringTime = Now() - begin;
+    begin = Now();
+    int h2 = LevelOrderParallel(roots,numRoots,ops,CollectStats,&b);
+    double parallelTime = Now() - begin;
+    int widest = 0;
+    for(int k = 0;k < a.levels && k < a.maxLevels;k++) if(a.width[k] > widest) widest = a.width[k];
+    printf("%-14s levels %d widest %d ring %.3fs (capacity %u) parallel %.3fs %s\n",name,h1,widest,ringTime,
+           Q->capacity,parallelTime,h1 == h2 && SameStats(&a,&b) ? "OK" : "MISMATCH");
+    FreeStats(&a);
+    FreeStats(&b);
+}
+
+int main() {
+    NodeRing Q;
+    InitRing(&Q,16);
+    //链表二叉树.c的例子
+    void *root = CreateLinkedTree("AB#CD#E###FG#HI#J####",21);
+    printf("GetLayer: ");
+    int height = LevelOrder(&Q,&root,1,&binaryOps,PrintNode,NULL,NULL);
+    FindArg find = {'J',-1};
+    LevelOrder(&Q,&root,1,&binaryOps,NULL,FindLevel,&find);
+    LevelStats stats;
+    InitStats(&stats,64);
+    LevelOrder(&Q,&root,1,&binaryOps,NULL,CollectStats,&stats);
+    printf("\nheight %d, J is in level %d, right view %s, widths",height,find.level,stats.right);
+    for(int k = 0;k < stats.levels;k++) printf(" %d",stats.width[k]);
+    printf("\n");
+    FreeStats(&stats);
+    FreeAll(&Q,&root,1,&binaryOps);
+    //森林-树-孩子兄弟表示法.c的三棵树
+    void *forest[3] = {CreateSiblingTree("ABEK##F##CG##DH#I#J####"),CreateSiblingTree("LM###"),CreateSiblingTree("N##")};
+    printf("GetLayerForest: ");
+    height = LevelOrder(&Q,forest,3,&siblingOps,PrintNode,NULL,NULL);
+    printf("\nHeightUpdate %d\n",height);
+    FreeAll(&Q,forest,3,&siblingOps);
+
+    printf("\n*******\n");
+    srand(2024);
+    //满二叉树，最宽一层2^21个结点
+    int levels = 22;
+    long long n = (1LL << levels) - 1,*order;
+    TreeNode *pool = (TreeNode*)ScatteredPool(sizeof(TreeNode),n,&order);
+    for(long long i = 0;i < n;i++) {
+        Tree E = &pool[order[i]];
+        E->data = (char)('A' + Rand32() % 26);
+        E->leftChild = 2 * i + 1 < n ? &pool[order[2 * i + 1]] : NULL;
+        E->rightChild = 2 * i + 2 < n ? &pool[order[2 * i + 2]] : NULL;
+    }
+    root = &pool[order[0]];
+    Benchmark("binary 2^22-1",&Q,&root,1,&binaryOps);
+    free(pool);
+    free(order);
+    //孩子兄弟表示的宽树：根有10^6个孩子，每个孩子有3个孩子
+    long long fan = 1000000;
+    n = 1 + fan * 4;
+    CSNode *nodes = (CSNode*)ScatteredPool(sizeof(CSNode),n,&order);
+    for(long long i = 0;i < n;i++) {
+        CSTree E = &nodes[order[i]];
+        E->data = (char)('a' + Rand32() % 26);
+        E->firstSon = E->nextBrother = NULL;
+    }
+    //编号：0为根，1..fan为第二层，之后每3个为一组孙子
+    for(long long i = 1;i <= fan;i++) {
+        CSTree E = &nodes[order[i]];
+        E->nextBrother = i < fan ? &nodes[order[i + 1]] : NULL;
+        long long g = fan + 1 + (i - 1) * 3;
+        E->firstSon = &nodes[order[g]];
+        nodes[order[g]].nextBrother = &nodes[order[g + 1]];
+        nodes[order[g + 1]].nextBrother = &nodes[order[g + 2]];
+    }
+    nodes[order[0]].firstSon = &nodes[order[1]];
+    root = &nodes[order[0]];
+    Benchmark("sibling 1+1M+3M",&Q,&root,1,&siblingOps);
+    free(nodes);
+    free(order);
+    DestroyRing(&Q);
+    return 0;
+}
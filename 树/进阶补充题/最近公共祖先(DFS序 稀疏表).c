@@ -0,0 +1,266 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../IndexTree.h"
+/*
+最近公共祖先(LCA)索引
+链表二叉树.c的PublicParent每次查询都要Find两遍(层序)再SearchPublicParent递归搜整棵树，O(n)一次
+这里对IndexTree.h的树建一次索引，O(n log n)建，O(1)查：
+1 前序遍历得到每个结点的前序号pre[]、双亲parent[]，order[k]为前序第k个结点
+2 设pre[u] < pre[v]，前序区间(pre[u],pre[v]]内的结点都在u的子树或u与v的公共祖先的其他子树里，
+  它们的双亲中前序号最小的就是LCA(u,v)(u为v的祖先时即为u)
+  这是欧拉序+RMQ去掉重复出现的双亲后的形式，数组长n而不是2n-1
+3 对 pre[parent[order[k]]] 建稀疏表：st[j][k]为区间[k,k+2^j)的最小值，任意区间由两段重叠的2^j区间求最小
+4 批量查询各自独立，编译时加-fopenmp则并行
+同时保存层序编号到结点的映射，PublicParent(i,j)的编号含义与链表二叉树.c的Find相同
+*/
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+typedef struct {
+    int numNodes; // 结点池大小(IndexTree的count)
+    int size; // 树中结点数
+    int *pre; // 结点下标->前序号
+    int *order; // 前序号->结点下标
+    int *layer; // 层序编号(从1开始)->结点下标
+    int *log2; // log2[len]
+    int levels;
+    int **st; // st[j][k]
+} LCAIndex;
+
+void FreeLCAIndex(LCAIndex *I) {
+    free(I->pre);
+    free(I->order);
+    free(I->layer);
+    free(I->log2);
+    for(int j = 0;j < I->levels;j++) free(I->st[j]);
+    free(I->st);
+    memset(I,0,sizeof(LCAIndex));
+}
+
+int BuildLCAIndex(LCAIndex *I,const IndexTree *T) {
+    int n = NodeCount(T); // 从根能走到的结点，池里可能还有别的结点
+    memset(I,0,sizeof(LCAIndex));
+    I->numNodes = T->count;
+    I->size = n;
+    I->pre = (int*)malloc(sizeof(int) * (T->count > 0 ? T->count : 1));
+    I->order = (int*)malloc(sizeof(int) * (n + 1));
+    I->layer = (int*)malloc(sizeof(int) * (n + 1));
+    I->log2 = (int*)malloc(sizeof(int) * (n + 1));
+    int *parent = (int*)malloc(sizeof(int) * (T->count > 0 ? T->count : 1));
+    int *stack = (int*)malloc(sizeof(int) * (n + 1));
+    if(!I->pre || !I->order || !I->layer || !I->log2 || !parent || !stack) {
+        free(parent);
+        free(stack);
+        FreeLCAIndex(I);
+        return 0;
+    }
+    //前序：弹出即编号，先压右再压左
+    int top = 0,k = 0;
+    if(T->root != NIL) {
+        stack[top++] = T->root;
+        parent[T->root] = NIL;
+    }
+    while(top) {
+        int v = stack[--top];
+        I->pre[v] = k;
+        I->order[k++] = v;
+        int l = T->node[v].leftChild,r = T->node[v].rightChild;
+        if(r != NIL) {
+            parent[r] = v;
+            stack[top++] = r;
+        }
+        if(l != NIL) {
+            parent[l] = v;
+            stack[top++] = l;
+        }
+    }
+    //层序编号，1开始
+    int head = 0,tail = 0;
+    if(T->root != NIL) I->layer[++tail] = T->root;
+    while(head < tail) {
+        int v = I->layer[++head];
+        if(T->node[v].leftChild != NIL) I->layer[++tail] = T->node[v].leftChild;
+        if(T->node[v].rightChild != NIL) I->layer[++tail] = T->node[v].rightChild;
+    }
+    //稀疏表
+    I->log2[1] = 0;
+    for(int len = 2;len <= n;len++) I->log2[len] = I->log2[len / 2] + 1;
+    I->levels = n > 0 ? I->log2[n] + 1 : 0;
+    I->st = (int**)calloc(I->levels > 0 ? I->levels : 1,sizeof(int*));
+    for(int j = 0;j < I->levels;j++) {
+        int count = n - (1 << j) + 1;
+        I->st[j] = (int*)malloc(sizeof(int) * count);
+        if(!I->st[j]) {
+            free(parent);
+            free(stack);
+            FreeLCAIndex(I);
+            return 0;
+        }
+        for(int i = 0;i < count;i++) {
+            if(j == 0) {
+                int p = parent[I->order[i]];
+                I->st[0][i] = p == NIL ? -1 : I->pre[p];
+            } else {
+                int a = I->st[j - 1][i],b = I->st[j - 1][i + (1 << (j - 1))];
+                I->st[j][i] = a < b ? a : b;
+            }
+        }
+    }
+    free(parent);
+    free(stack);
+    return 1;
+}
+//结点下标u,v的最近公共祖先
+int LCA(const LCAIndex *I,int u,int v) {
+    if(u == v) return u;
+    int l = I->pre[u],r = I->pre[v];
+    if(l > r) {
+        int tmp = l;
+        l = r;
+        r = tmp;
+    }
+    //区间[l+1,r]
+    l++;
+    int j = I->log2[r - l + 1];
+    int a = I->st[j][l],b = I->st[j][r - (1 << j) + 1];
+    return I->order[a < b ? a : b];
+}
+
+void LCABatch(const LCAIndex *I,const int *u,const int *v,int q,int *out) {
+    #pragma omp parallel for schedule(static)
+    for(int i = 0;i < q;i++) out[i] = LCA(I,u[i],v[i]);
+}
+//代替链表二叉树.c的PublicParent：i,j为层序编号
+void PublicParent(const LCAIndex *I,const IndexTree *T,int i,int j) {
+    if(i < 1 || i > I->size || j < 1 || j > I->size) {
+        return;
+    }
+    printf("Nearest is %c\n",T->node[LCA(I,I->layer[i],I->layer[j])].data);
+}
+
+/* 对照 ********************************************* */
+//同SearchPublicParent，每次查询搜整棵树(递归)
+int SearchPublicParent(const IndexTree *T,int v,int a,int b) {
+    if(v == NIL || v == a || v == b) return v;
+    int left = SearchPublicParent(T,T->node[v].leftChild,a,b);
+    int right = SearchPublicParent(T,T->node[v].rightChild,a,b);
+    if(left != NIL && right != NIL) return v;
+    return left != NIL ? left : right;
+}
+//沿双亲往上爬的朴素LCA，用于校验
+int ClimbLCA(const int *parent,const int *depth,int u,int v) {
+    while(depth[u] > depth[v]) u = parent[u];
+    while(depth[v] > depth[u]) v = parent[v];
+    while(u != v) {
+        u = parent[u];
+        v = parent[v];
+    }
+    return u;
+}
+//随机形状的树，同 下标二叉树(连续结点池).c
+int RandomPreorder(char *chars,int numNodes) {
+    int *stack = (int*)malloc(sizeof(int) * (numNodes + 2)),top = 0,length = 0;
+    stack[top++] = numNodes;
+    while(top) {
+        int size = stack[--top];
+        if(size == 0) {
+            chars[length++] = '#';
+            continue;
+        }
+        int left = (int)(((unsigned)rand() * 32768u + rand()) % size);
+        chars[length++] = (char)('A' + rand() % 26);
+        stack[top++] = size - 1 - left;
+        stack[top++] = left;
+    }
+    free(stack);
+    return length;
+}
+
+double Now() {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+int main() {
+    //链表二叉树.c中的例子，层序编号见其main中的图
+    IndexTree T;
+    LCAIndex I;
+    InitIndexTree(&T,16);
+    const char *example = "AB#CD#E###FG#HI#J####";
+    CreateIndexTree(&T,example,(int)strlen(example));
+    BuildLCAIndex(&I,&T);
+    int pairs[][2] = {{9,7},{1,2},{4,5},{8,10},{6,10},{3,3}};
+    for(int k = 0;k < 6;k++) {
+        int i = pairs[k][0],j = pairs[k][1];
+        printf("PublicParent(%d,%d) ",i,j);
+        PublicParent(&I,&T,i,j);
+        int expect = SearchPublicParent(&T,T.root,I.layer[i],I.layer[j]);
+        if(expect != LCA(&I,I.layer[i],I.layer[j])) printf("  MISMATCH with SearchPublicParent\n");
+    }
+    FreeLCAIndex(&I);
+
+    printf("\n*******\n");
+    srand(2024);
+    int n = 1000000,q = 1000000;
+    char *chars = (char*)malloc(2 * n + 1);
+    int length = RandomPreorder(chars,n);
+    CreateIndexTree(&T,chars,length);
+    double begin = Now();
+    BuildLCAIndex(&I,&T);
+    double buildTime = Now() - begin;
+    size_t bytes = sizeof(int) * ((size_t)T.count + 3 * (size_t)n);
+    for(int j = 0;j < I.levels;j++) bytes += sizeof(int) * (size_t)(n - (1 << j) + 1);
+    printf("n=%d build %.3fs index %.1f MB\n",n,buildTime,bytes / 1048576.0);
+    int *u = (int*)malloc(sizeof(int) * q),*v = (int*)malloc(sizeof(int) * q),*answer = (int*)malloc(sizeof(int) * q);
+    for(int i = 0;i < q;i++) {
+        u[i] = I.order[((unsigned)rand() * 32768u + rand()) % n];
+        v[i] = I.order[((unsigned)rand() * 32768u + rand()) % n];
+    }
+    begin = Now();
+    LCABatch(&I,u,v,q,answer);
+    double batchTime = Now() - begin;
+    printf("Batch %d queries %.3fs, %.1f ns/query\n",q,batchTime,batchTime * 1e9 / q);
+    //整树搜索只跑100次
+    begin = Now();
+    int wrong = 0;
+    for(int i = 0;i < 100;i++) wrong += SearchPublicParent(&T,T.root,u[i],v[i]) != answer[i];
+    double searchTime = Now() - begin;
+    printf("SearchPublicParent 100 queries %.3fs, %.1f us/query, wrong %d\n",searchTime,searchTime * 1e4,wrong);
+    //全部查询用爬双亲的方法校验
+    int *parent = (int*)malloc(sizeof(int) * T.count),*depth = (int*)malloc(sizeof(int) * T.count);
+    for(int k = 0;k < n;k++) {
+        int x = I.order[k];
+        if(x == T.root) {
+            parent[x] = NIL;
+            depth[x] = 0;
+        }
+        //前序中双亲先于孩子
+        int l = T.node[x].leftChild,r = T.node[x].rightChild;
+        if(l != NIL) {
+            parent[l] = x;
+            depth[l] = depth[x] + 1;
+        }
+        if(r != NIL) {
+            parent[r] = x;
+            depth[r] = depth[x] + 1;
+        }
+    }
+    wrong = 0;
+    for(int i = 0;i < q;i++) wrong += ClimbLCA(parent,depth,u[i],v[i]) != answer[i];
+    printf("Verify all %d answers by climbing parents: wrong %d\n",q,wrong);
+    free(parent);
+    free(depth);
+    free(u);
+    free(v);
+    free(answer);
+    free(chars);
+    FreeLCAIndex(&I);
+    DestroyIndexTree(&T);
+    return 0;
+}
@@ -0,0 +1,313 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../CompactForest.h"
+/*
+紧凑森林：由孩子兄弟表示、孩子链表表示转换，二进制文件mmap加载
+森林-树-孩子兄弟表示法.c、树-孩子链表表示法.c的结点各自malloc，HeightUpdate/LeafCount递归，
+这里转换成CompactForest.h的层序数组后：高度沿双亲走一条链，叶子数、度顺序扫一遍childStart，
+先根遍历用显式栈，保存后下次直接mmap，不需要重新建树
+用法：./a.out [结点数=10000000]
+*/
+#define MAXSIZES 100
+#define MAXSIZE 20
+
+/* 孩子兄弟表示(森林-树-孩子兄弟表示法.c) ************ */
+typedef struct TreeNode {
+    char data;
+    struct TreeNode *firstSon,*nextBrother;
+} TreeNode,*Tree;
+
+typedef struct {
+    Tree root[MAXSIZES];
+    int treeCount;
+} Forest;
+//同CreateTree：前序串，#为空，用栈代替递归
+Tree CreateTree(const char *chars) {
+    Tree root = NULL;
+    int length = (int)strlen(chars),top = 0;
+    Tree **slot = (Tree**)malloc(sizeof(Tree*) * (length + 1));
+    slot[top++] = &root;
+    for(int i = 0;top && i < length;i++) {
+        Tree *s = slot[--top];
+        if(chars[i] == '#') {
+            *s = NULL;
+        } else {
+            *s = (Tree)malloc(sizeof(TreeNode));
+            (*s)->data = chars[i];
+            slot[top++] = &(*s)->nextBrother;
+            slot[top++] = &(*s)->firstSon;
+        }
+    }
+    free(slot);
+    return root;
+}
+//按层序编号：数组本身当队列，出队的结点把孩子依次追加到末尾
+int FromSiblingForest(CompactForest *F,const Forest *S) {
+    int n = 0,top = 0;
+    Tree *stack = (Tree*)malloc(sizeof(Tree) * 64);
+    int capacity = 64;
+    //先数结点数
+    for(int i = 0;i < S->treeCount;i++) if(S->root[i]) stack[top++] = S->root[i];
+    while(top) {
+        Tree E = stack[--top];
+        n++;
+        if(top + 2 > capacity) {
+            capacity *= 2;
+            stack = (Tree*)realloc(stack,sizeof(Tree) * capacity);
+        }
+        if(E->nextBrother) stack[top++] = E->nextBrother;
+        if(E->firstSon) stack[top++] = E->firstSon;
+    }
+    free(stack);
+    int numRoots = 0;
+    for(int i = 0;i < S->treeCount;i++) numRoots += S->root[i] != NULL;
+    Tree *queue = (Tree*)malloc(sizeof(Tree) * (n > 0 ? n : 1));
+    if(!queue || !AllocCompactForest(F,n,numRoots)) {
+        free(queue);
+        FreeCompactForest(F);
+        return 0;
+    }
+    int tail = 0;
+    for(int i = 0;i < S->treeCount;i++) if(S->root[i]) queue[tail++] = S->root[i];
+    for(int v = 0;v < n;v++) {
+        F->data[v] = queue[v]->data;
+        F->childStart[v] = tail;
+        for(Tree c = queue[v]->firstSon;c;c = c->nextBrother) queue[tail++] = c;
+    }
+    F->childStart[n] = tail;
+    free(queue);
+    FillParent(F);
+    return 1;
+}
+//转回孩子兄弟表示，结点一次分配成一个数组(root[0]指向数组开头)
+int ToSiblingForest(const CompactForest *F,Forest *S,Tree *pool) {
+    *pool = (Tree)malloc(sizeof(TreeNode) * (F->numNodes > 0 ? F->numNodes : 1));
+    if(!*pool || F->numRoots > MAXSIZES) return 0;
+    for(int v = 0;v < F->numNodes;v++) {
+        Tree E = *pool + v;
+        E->data = F->data[v];
+        E->firstSon = Degree(F,v) ? *pool + F->childStart[v] : NULL;
+        //兄弟：同一双亲的下一个孩子；根之间不相连
+        int last = v < F->numRoots ? v : F->childStart[F->parent[v] + 1] - 1;
+        E->nextBrother = v < last ? *pool + v + 1 : NULL;
+    }
+    S->treeCount = F->numRoots;
+    for(int r = 0;r < F->numRoots;r++) S->root[r] = *pool + r;
+    return 1;
+}
+//原来的递归写法，用于对照
+int leafCount = 0;
+void LeafCount(Tree T) {
+    if(T != NULL) {
+        if(T->firstSon == NULL) leafCount++;
+        LeafCount(T->firstSon);
+        LeafCount(T->nextBrother);
+    }
+}
+
+void DestroyTree(Tree T) {
+    if(T) {
+        DestroyTree(T->firstSon);
+        DestroyTree(T->nextBrother);
+        free(T);
+    }
+}
+
+/* 孩子链表表示(树-孩子链表表示法.c) ****************** */
+typedef struct Node {
+    struct Node *next;
+    char data;
+} Node,*LinkList;
+
+typedef struct {
+    char data;
+    LinkList firstChild;
+} TreeHeadNode;
+
+typedef struct {
+    TreeHeadNode nodes[MAXSIZE];
+    int nodeCount,rootPlace;
+} ChildTree;
+//孩子链表里存的是孩子的data，先建data到表头下标的映射
+int FromChildTree(CompactForest *F,const ChildTree *T) {
+    int place[256],n = T->nodeCount;
+    for(int k = 0;k < 256;k++) place[k] = -1;
+    for(int i = 0;i < n;i++) place[(unsigned char)T->nodes[i].data] = i;
+    int *queue = (int*)malloc(sizeof(int) * (n > 0 ? n : 1)),tail = 0;
+    if(!queue || !AllocCompactForest(F,n,n > 0)) {
+        free(queue);
+        FreeCompactForest(F);
+        return 0;
+    }
+    if(n > 0) queue[tail++] = T->rootPlace;
+    for(int v = 0;v < tail;v++) {
+        F->data[v] = T->nodes[queue[v]].data;
+        F->childStart[v] = tail;
+        for(LinkList p = T->nodes[queue[v]].firstChild;p;p = p->next) {
+            int i = place[(unsigned char)p->data];
+            if(i < 0 || tail == n) {
+                //孩子不在表中，或者有结点出现两次(不是树)
+                free(queue);
+                FreeCompactForest(F);
+                return 0;
+            }
+            queue[tail++] = i;
+        }
+    }
+    F->numNodes = tail; // 从根走不到的结点不算
+    F->childStart[tail] = tail;
+    free(queue);
+    FillParent(F);
+    return 1;
+}
+
+void AddChildren(ChildTree *T,int i,const char *children) {
+    LinkList *tail = &T->nodes[i].firstChild;
+    for(const char *c = children;*c;c++) {
+        *tail = (LinkList)malloc(sizeof(Node));
+        (*tail)->data = *c;
+        (*tail)->next = NULL;
+        tail = &(*tail)->next;
+    }
+}
+
+/* 演示 ********************************************* */
+void PrintForest(const char *name,const CompactForest *F) {
+    printf("%s: preorder ",name);
+    ForestPreorder(F,NULL);
+    printf(" height %d leaves %d degree %d\n  parent",ForestHeight(F),ForestLeafCount(F),ForestDegree(F));
+    for(int v = 0;v < F->numNodes;v++) printf(" %d",F->parent[v]);
+    printf("\n  childStart");
+    for(int v = 0;v <= F->numNodes;v++) printf(" %d",F->childStart[v]);
+    printf("\n  LOUDS ");
+    for(long long p = 0;p < F->loudsBits;p++) printf("%d",(int)(F->louds[p >> 6] >> (p & 63) & 1));
+    printf("\n");
+}
+//LOUDS的孩子、双亲与CSR、parent数组一致
+int CheckLouds(const CompactForest *F,int queries) {
+    int wrong = 0;
+    for(int q = 0;q < queries;q++) {
+        int v = queries >= F->numNodes ? q % (F->numNodes > 0 ? F->numNodes : 1)
+                                       : (int)(((unsigned)rand() * 32768u + rand()) % F->numNodes);
+        if(F->numNodes == 0) break;
+        int degree,first = LoudsFirstChild(F,v,&degree);
+        wrong += degree != Degree(F,v) || (degree && first != F->childStart[v]) || LoudsParent(F,v) != F->parent[v];
+    }
+    return wrong;
+}
+//随机森林：按层序依次给每个结点0~3个孩子，队列空了还没到n就至少给一个。根数不超过n
+int RandomForest(CompactForest *F,int n,int numRoots) {
+    if(numRoots > n) numRoots = n;
+    if(!AllocCompactForest(F,n,numRoots)) {
+        FreeCompactForest(F);
+        return 0;
+    }
+    int next = numRoots;
+    for(int v = 0;v < n;v++) {
+        int d = rand() % 4;
+        if(next == v + 1 && d == 0) d = 1;
+        if(d > n - next) d = n - next;
+        F->childStart[v] = next;
+        F->data[v] = (char)('A' + rand() % 26);
+        next += d;
+    }
+    F->childStart[n] = next;
+    FillParent(F);
+    return 1;
+}
+
+double Elapsed(clock_t begin) {
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+int main(int argc,char **argv) {
+    //森林-树-孩子兄弟表示法.c main中的三棵树
+    Forest S;
+    S.treeCount = 3;
+    S.root[0] = CreateTree("ABEK##F##CG##DH#I#J####");
+    S.root[1] = CreateTree("LM###");
+    S.root[2] = CreateTree("N##");
+    CompactForest F;
+    FromSiblingForest(&F,&S);
+    BuildLouds(&F);
+    PrintForest("Sibling forest",&F);
+    printf("  LOUDS check wrong %d\n",CheckLouds(&F,F.numNodes));
+    for(int i = 0;i < S.treeCount;i++) DestroyTree(S.root[i]);
+    FreeCompactForest(&F);
+    //树-孩子链表表示法.c注释中的树
+    ChildTree T;
+    const char *heads = "ABCDEFGHIJK";
+    const char *children[] = {"BC","DE","FJ","H","","IG","","K","","",""};
+    T.nodeCount = 11;
+    T.rootPlace = 0;
+    for(int i = 0;i < T.nodeCount;i++) {
+        T.nodes[i].data = heads[i];
+        T.nodes[i].firstChild = NULL;
+        AddChildren(&T,i,children[i]);
+    }
+    FromChildTree(&F,&T);
+    BuildLouds(&F);
+    PrintForest("Child-list tree",&F);
+    printf("  LOUDS check wrong %d\n",CheckLouds(&F,F.numNodes));
+    FreeCompactForest(&F);
+    for(int i = 0;i < T.nodeCount;i++) {
+        for(LinkList p = T.nodes[i].firstChild,q;p;p = q) {
+            q = p->next;
+            free(p);
+        }
+    }
+
+    printf("\n*******\n");
+    srand(2024);
+    int n = argc > 1 ? atoi(argv[1]) : 10000000;
+    if(n <= 0) {
+        printf("node count must be positive\n");
+        return 1;
+    }
+    const char *path = "forest.bin";
+    clock_t begin = clock();
+    if(!RandomForest(&F,n,10) || !BuildLouds(&F)) {
+        printf("out of memory\n");
+        FreeCompactForest(&F);
+        return 1;
+    }
+    printf("n=%d build %.3fs, memory parent+childStart+data %.1f MB, LOUDS %.1f MB\n",n,Elapsed(begin),
+           (9.0 * n + 4) / 1048576,(F.loudsBits / 8.0 + 4.0 * LoudsBlocks(F.loudsBits)) / 1048576);
+    begin = clock();
+    int saved = SaveCompactForest(path,&F);
+    printf("save %s %.3fs\n",saved ? "OK" : "FAILED",Elapsed(begin));
+    char *expect = (char*)malloc(n > 0 ? n : 1),*got = (char*)malloc(n > 0 ? n : 1);
+    ForestPreorder(&F,expect);
+    int height = ForestHeight(&F),leaves = ForestLeafCount(&F);
+    //指针版对照：转回孩子兄弟表示，递归数叶子
+    Tree pool;
+    ToSiblingForest(&F,&S,&pool);
+    begin = clock();
+    leafCount = 0;
+    for(int i = 0;i < S.treeCount;i++) LeafCount(S.root[i]);
+    printf("pointer LeafCount (recursive) %.3fs leaves %d\n",Elapsed(begin),leafCount);
+    free(pool);
+    FreeCompactForest(&F);
+
+    CompactForest M;
+    begin = clock();
+    if(!saved || !MapCompactForest(path,&M)) return 1;
+    printf("map %.6fs\n",Elapsed(begin));
+    begin = clock();
+    int mappedHeight = ForestHeight(&M),mappedLeaves = ForestLeafCount(&M);
+    printf("mapped height %d leaves %d %.3fs %s\n",mappedHeight,mappedLeaves,Elapsed(begin),
+           mappedHeight == height && mappedLeaves == leaves && leaves == leafCount ? "OK" : "MISMATCH");
+    begin = clock();
+    ForestPreorder(&M,got);
+    printf("mapped preorder %.3fs %s\n",Elapsed(begin),memcmp(expect,got,n) == 0 ? "OK" : "MISMATCH");
+    begin = clock();
+    int queries = 1000000,wrong = CheckLouds(&M,queries);
+    printf("%d LOUDS child+parent queries %.3fs wrong %d\n",queries,Elapsed(begin),wrong);
+    FreeCompactForest(&M);
+    remove(path);
+    free(expect);
+    free(got);
+    return 0;
+}
@@ -0,0 +1,380 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*
+中序线索二叉排序树做有序集合
+线索二叉树.c的MiddleThread/HeadThread靠全局treePre递归地一次性线索化，建好后不能再改，Insert也只处理了一种情况
+这里线索随插入、删除同步维护，树一直是线索化的：
+1 游标就是结点指针，Next/Prev不用栈：右标志为THREAD时右指针直接是后继，
+  否则走到右子树最左结点。整棵树走一遍每条边最多经过两次，均摊O(1)
+2 中序第一个结点的左线索、最后一个结点的右线索为NULL，与MiddleThread相同
+3 插入：新结点总是叶子，它的前驱、后继恰好是挂上去的双亲与双亲原来的线索
+4 删除：有两个孩子时把后继的关键字搬上来改删后继；只有一个孩子时把子树中与被删结点
+  相邻的那个结点的线索改指过去；叶子则把双亲的孩子指针还原成线索
+  删除后指向被删结点和(两个孩子时)其后继的游标失效，其余游标仍有效
+5 区间扫描：LowerBound定位到第一个>=lo的结点，再沿Next走到>hi为止
+不做平衡，随机插入时树高期望O(log n)
+与栈迭代对比：两者访问的结点相同，但线索版回到祖先要先读出叶子的右线索才知道祖先的地址，
+栈版的祖先地址在栈里，几次缓存缺失可以重叠，结点散落在堆上时栈版整树扫描反而更快
+线索版的好处在于游标只是一个指针：不占栈、可以保存下来稍后继续，插入删除其他结点后仍然有效
+*/
+#define OK 1
+#define ERROR 0
+#define CHILD 0
+#define THREAD 1
+
+typedef int Status;
+typedef unsigned char Tag; // 两个标志各1字节，结点24字节，与不带标志的链表结点一样大
+typedef int KeyType;
+
+typedef struct TreeNode {
+    KeyType key;
+    Tag leftTag,rightTag;
+    struct TreeNode *leftChild,*rightChild;
+} TreeNode,*Tree;
+
+typedef struct {
+    Tree root;
+    int size;
+} ThreadSet;
+
+typedef int (*ScanVisitor)(KeyType key,void *arg);
+
+void InitThreadSet(ThreadSet *S) {
+    S->root = NULL;
+    S->size = 0;
+}
+
+/* 游标 ********************************************* */
+Tree First(const ThreadSet *S) {
+    Tree p = S->root;
+    if(p) while(p->leftTag == CHILD) p = p->leftChild;
+    return p;
+}
+
+Tree Last(const ThreadSet *S) {
+    Tree p = S->root;
+    if(p) while(p->rightTag == CHILD) p = p->rightChild;
+    return p;
+}
+//中序后继，没有返回NULL
+Tree Next(Tree p) {
+    if(p->rightTag == THREAD) return p->rightChild;
+    p = p->rightChild;
+    while(p->leftTag == CHILD) p = p->leftChild;
+    return p;
+}
+//中序前驱，没有返回NULL
+Tree Prev(Tree p) {
+    if(p->leftTag == THREAD) return p->leftChild;
+    p = p->leftChild;
+    while(p->rightTag == CHILD) p = p->rightChild;
+    return p;
+}
+
+Tree Find(const ThreadSet *S,KeyType key) {
+    Tree p = S->root;
+    while(p) {
+        if(key == p->key) return p;
+        if(key < p->key) {
+            if(p->leftTag == THREAD) return NULL;
+            p = p->leftChild;
+        } else {
+            if(p->rightTag == THREAD) return NULL;
+            p = p->rightChild;
+        }
+    }
+    return NULL;
+}
+//第一个关键字>=key的结点，没有返回NULL
+Tree LowerBound(const ThreadSet *S,KeyType key) {
+    Tree p = S->root,candidate = NULL;
+    while(p) {
+        if(p->key >= key) {
+            candidate = p;
+            if(p->leftTag == THREAD) break;
+            p = p->leftChild;
+        } else {
+            if(p->rightTag == THREAD) break;
+            p = p->rightChild;
+        }
+    }
+    return candidate;
+}
+
+/* 插入删除 ***************************************** */
+//已存在返回ERROR
+Status Insert(ThreadSet *S,KeyType key) {
+    Tree p = S->root;
+    while(p) {
+        if(key == p->key) return ERROR;
+        if(key < p->key) {
+            if(p->leftTag == THREAD) break;
+            p = p->leftChild;
+        } else {
+            if(p->rightTag == THREAD) break;
+            p = p->rightChild;
+        }
+    }
+    Tree newNode = (Tree)malloc(sizeof(TreeNode));
+    if(!newNode) return ERROR;
+    newNode->key = key;
+    newNode->leftTag = newNode->rightTag = THREAD;
+    if(p == NULL) {
+        newNode->leftChild = newNode->rightChild = NULL;
+        S->root = newNode;
+    } else if(key < p->key) {
+        //挂为左孩子：前驱是p原来的前驱，后继是p
+        newNode->leftChild = p->leftChild;
+        newNode->rightChild = p;
+        p->leftTag = CHILD;
+        p->leftChild = newNode;
+    } else {
+        newNode->leftChild = p;
+        newNode->rightChild = p->rightChild;
+        p->rightTag = CHILD;
+        p->rightChild = newNode;
+    }
+    S->size++;
+    return OK;
+}
+//把parent中指向p的孩子指针换成child(child为NULL时还原成线索thread)
+void Replace(ThreadSet *S,Tree parent,Tree p,Tree child,Tree thread) {
+    if(parent == NULL) {
+        S->root = child;
+    } else if(parent->leftTag == CHILD && parent->leftChild == p) {
+        parent->leftChild = child ? child : thread;
+        parent->leftTag = child ? CHILD : THREAD;
+    } else {
+        parent->rightChild = child ? child : thread;
+        parent->rightTag = child ? CHILD : THREAD;
+    }
+}
+//不存在返回ERROR
+Status Delete(ThreadSet *S,KeyType key) {
+    Tree p = S->root,parent = NULL;
+    while(p && key != p->key) {
+        parent = p;
+        if(key < p->key) p = p->leftTag == CHILD ? p->leftChild : NULL;
+        else p = p->rightTag == CHILD ? p->rightChild : NULL;
+    }
+    if(p == NULL) return ERROR;
+    if(p->leftTag == CHILD && p->rightTag == CHILD) {
+        //后继是右子树最左结点，它没有左孩子
+        Tree q = p->rightChild;
+        parent = p;
+        while(q->leftTag == CHILD) {
+            parent = q;
+            q = q->leftChild;
+        }
+        p->key = q->key;
+        p = q;
+    }
+    if(p->leftTag == THREAD && p->rightTag == THREAD) {
+        //叶子：双亲是它的前驱或后继，还原成线索
+        if(parent && parent->leftTag == CHILD && parent->leftChild == p) Replace(S,parent,p,NULL,p->leftChild);
+        else Replace(S,parent,p,NULL,p->rightChild);
+    } else if(p->leftTag == CHILD) {
+        //只有左子树：p的前驱(左子树最右结点)的右线索原来指向p，改指p的后继
+        Tree pre = p->leftChild;
+        while(pre->rightTag == CHILD) pre = pre->rightChild;
+        pre->rightChild = p->rightChild;
+        Replace(S,parent,p,p->leftChild,NULL);
+    } else {
+        Tree next = p->rightChild;
+        while(next->leftTag == CHILD) next = next->leftChild;
+        next->leftChild = p->leftChild;
+        Replace(S,parent,p,p->rightChild,NULL);
+    }
+    free(p);
+    S->size--;
+    return OK;
+}
+//沿线索释放：先取后继再释放当前结点，后继只会经过还没释放的结点
+void DestroyThreadSet(ThreadSet *S) {
+    Tree p = First(S);
+    while(p) {
+        Tree q = Next(p);
+        free(p);
+        p = q;
+    }
+    InitThreadSet(S);
+}
+
+/* 区间扫描 ***************************************** */
+//按升序访问[lo,hi]内的关键字，visit返回0则停止。返回访问的个数
+int RangeScan(const ThreadSet *S,KeyType lo,KeyType hi,ScanVisitor visit,void *arg) {
+    int n = 0;
+    for(Tree p = LowerBound(S,lo);p && p->key <= hi;p = Next(p)) {
+        n++;
+        if(!visit(p->key,arg)) break;
+    }
+    return n;
+}
+//同RangeScan，结果写入out(最多max个)
+int RangeCollect(const ThreadSet *S,KeyType lo,KeyType hi,KeyType *out,int max) {
+    int n = 0;
+    for(Tree p = LowerBound(S,lo);p && p->key <= hi && n < max;p = Next(p)) out[n++] = p->key;
+    return n;
+}
+
+/* 对照：不带线索的二叉排序树，用栈迭代 *************** */
+typedef struct PlainNode {
+    KeyType key;
+    struct PlainNode *leftChild,*rightChild;
+} PlainNode,*PlainTree;
+
+Status PlainInsert(PlainTree *T,KeyType key) {
+    while(*T) {
+        if(key == (*T)->key) return ERROR;
+        T = key < (*T)->key ? &(*T)->leftChild : &(*T)->rightChild;
+    }
+    *T = (PlainTree)malloc(sizeof(PlainNode));
+    (*T)->key = key;
+    (*T)->leftChild = (*T)->rightChild = NULL;
+    return OK;
+}
+
+void PlainDestroy(PlainTree T,PlainTree *stack) {
+    int top = 0;
+    if(T) stack[top++] = T;
+    while(top) {
+        PlainTree p = stack[--top];
+        if(p->leftChild) stack[top++] = p->leftChild;
+        if(p->rightChild) stack[top++] = p->rightChild;
+        free(p);
+    }
+}
+//栈中存还没访问的祖先：定位lo时向左走的结点入栈，之后与GetMiddle的非递归写法相同
+//stack由调用者提供，大小不小于树高
+int PlainRangeSum(PlainTree T,KeyType lo,KeyType hi,PlainTree *stack,long long *sum) {
+    int top = 0,n = 0;
+    while(T) {
+        if(T->key >= lo) {
+            stack[top++] = T;
+            T = T->leftChild;
+        } else {
+            T = T->rightChild;
+        }
+    }
+    while(top) {
+        PlainTree p = stack[--top];
+        if(p->key > hi) break;
+        n++;
+        *sum += p->key;
+        for(p = p->rightChild;p;p = p->leftChild) stack[top++] = p;
+    }
+    return n;
+}
+
+/* 演示 ********************************************* */
+int PrintKey(KeyType key,void *arg) {
+    (void)arg;
+    printf("%c",(char)key);
+    return 1;
+}
+
+typedef struct {
+    long long sum;
+    int limit;
+} SumArg;
+
+int SumKey(KeyType key,void *arg) {
+    SumArg *a = (SumArg*)arg;
+    a->sum += key;
+    return --a->limit > 0;
+}
+//检查中序严格递增、Prev与Next互逆、个数等于size
+Status CheckThreads(const ThreadSet *S) {
+    int n = 0;
+    Tree prv = NULL;
+    for(Tree p = First(S);p;p = Next(p)) {
+        if(prv && (prv->key >= p->key || Prev(p) != prv)) return ERROR;
+        prv = p;
+        n++;
+    }
+    return n == S->size && prv == Last(S) && (prv == NULL || Prev(First(S)) == NULL) ? OK : ERROR;
+}
+
+unsigned Rand32() {
+    return (unsigned)rand() * 32768u + rand();
+}
+
+double Elapsed(clock_t begin) {
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    ThreadSet S;
+    InitThreadSet(&S);
+    const char *letters = "FBIADGKCEHJ";
+    for(int i = 0;letters[i];i++) Insert(&S,letters[i]);
+    printf("Next: ");
+    for(Tree p = First(&S);p;p = Next(p)) printf("%c",(char)p->key);
+    printf("\nPrev: ");
+    for(Tree p = Last(&S);p;p = Prev(p)) printf("%c",(char)p->key);
+    printf("\nScan [C,H]: ");
+    RangeScan(&S,'C','H',PrintKey,NULL);
+    //叶子、只有一个孩子、两个孩子各删一个
+    Delete(&S,'C');
+    Delete(&S,'K');
+    Delete(&S,'F');
+    printf("\nDelete C,K,F: ");
+    for(Tree p = First(&S);p;p = Next(p)) printf("%c",(char)p->key);
+    printf(" threads %s\n",CheckThreads(&S) ? "OK" : "BROKEN");
+    DestroyThreadSet(&S);
+
+    printf("\n*******\n");
+    srand(2024);
+    int n = 1000000,queries = 200000,width = 256;
+    KeyType *keys = (KeyType*)malloc(sizeof(KeyType) * n);
+    PlainTree P = NULL;
+    //关键字取偶数，区间的端点随机落在已有关键字之间
+    for(int i = 0;i < n;i++) keys[i] = (KeyType)(Rand32() % (8u * n)) * 2;
+    clock_t begin = clock();
+    for(int i = 0;i < n;i++) Insert(&S,keys[i]);
+    double threadBuild = Elapsed(begin);
+    begin = clock();
+    for(int i = 0;i < n;i++) PlainInsert(&P,keys[i]);
+    double plainBuild = Elapsed(begin);
+    PlainTree *stack = (PlainTree*)malloc(sizeof(PlainTree) * (S.size + 1));
+    printf("n=%d distinct %d insert threaded %.3fs plain %.3fs, threads %s\n",n,S.size,threadBuild,plainBuild,
+           CheckThreads(&S) ? "OK" : "BROKEN");
+    //整树升序遍历
+    long long sum1 = 0,sum2 = 0;
+    begin = clock();
+    for(Tree p = First(&S);p;p = Next(p)) sum1 += p->key;
+    double threadFull = Elapsed(begin);
+    begin = clock();
+    PlainRangeSum(P,0,0x7fffffff,stack,&sum2);
+    printf("full scan threaded %.3fs stack %.3fs %s\n",threadFull,Elapsed(begin),sum1 == sum2 ? "OK" : "MISMATCH");
+    //区间扫描：每个区间约width/16个关键字
+    KeyType *lo = (KeyType*)malloc(sizeof(KeyType) * queries);
+    for(int i = 0;i < queries;i++) lo[i] = (KeyType)(Rand32() % (16u * n));
+    long long visited1 = 0,visited2 = 0;
+    sum1 = sum2 = 0;
+    begin = clock();
+    for(int i = 0;i < queries;i++) {
+        SumArg a = {0,0x7fffffff};
+        visited1 += RangeScan(&S,lo[i],lo[i] + width,SumKey,&a);
+        sum1 += a.sum;
+    }
+    double threadRange = Elapsed(begin);
+    begin = clock();
+    for(int i = 0;i < queries;i++) visited2 += PlainRangeSum(P,lo[i],lo[i] + width,stack,&sum2);
+    double plainRange = Elapsed(begin);
+    printf("%d range scans (%.1f keys each) threaded %.3fs stack %.3fs %s\n",queries,(double)visited1 / queries,
+           threadRange,plainRange,sum1 == sum2 && visited1 == visited2 ? "OK" : "MISMATCH");
+    //删掉一半再检查
+    begin = clock();
+    int deleted = 0;
+    for(int i = 0;i < n;i += 2) deleted += Delete(&S,keys[i]);
+    printf("delete %d keys %.3fs, size %d threads %s\n",deleted,Elapsed(begin),S.size,CheckThreads(&S) ? "OK" : "BROKEN");
+    PlainDestroy(P,stack);
+    DestroyThreadSet(&S);
+    free(stack);
+    free(keys);
+    free(lo);
+    return 0;
+}
@@ -0,0 +1,375 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*
+二叉树遍历引擎
+链表二叉树.c的GetHead/GetMiddle/GetTail/Height/NodeCount/LeafCount都是递归，
+退化成链的树深度到10^5左右就会把C栈用完；遍历非递归算法.c只是三种非递归遍历的草稿，
+链表二叉树.c里的Stacks又是MAXSIZE大小的定长数组
+这里：
+1 显式栈、队列放在堆上，满了就翻倍扩容，深度只受内存限制
+2 Morris中序/前序：借叶子空着的右指针临时指回后继，O(1)额外空间，结束时树恢复原样
+3 访问者：每访问一个结点调用 visit(node,arg)，返回0则提前结束遍历
+  遍历函数返回1表示走完，0表示被访问者终止，-1表示内存不足
+  Morris被提前终止时仍要走完剩下的结点(不再调用visit)把临时指针拆掉
+  Morris访问时结点的右指针可能正是临时指针，visit中不能依赖孩子指针(如判断叶子)
+*/
+#define OK 1
+#define ERROR 0
+
+typedef int Status;
+typedef char ElemTypes;
+
+typedef struct TreeNode {
+    ElemTypes data;
+    struct TreeNode *leftChild,*rightChild;
+} TreeNode,*Tree;
+
+typedef int (*Visitor)(Tree node,void *arg);
+
+/* 可扩容的栈 *************************************** */
+typedef struct {
+    Tree *data;
+    int top; // 元素个数
+    int capacity;
+} NodeStack;
+
+Status InitNodeStack(NodeStack *S) {
+    S->capacity = 64;
+    S->top = 0;
+    S->data = (Tree*)malloc(sizeof(Tree) * S->capacity);
+    return S->data ? OK : ERROR;
+}
+
+void FreeNodeStack(NodeStack *S) {
+    free(S->data);
+    S->data = NULL;
+    S->top = S->capacity = 0;
+}
+
+Status PushNode(NodeStack *S,Tree E) {
+    if(S->top == S->capacity) {
+        Tree *grown = (Tree*)realloc(S->data,sizeof(Tree) * S->capacity * 2);
+        if(!grown) return ERROR;
+        S->data = grown;
+        S->capacity *= 2;
+    }
+    S->data[S->top++] = E;
+    return OK;
+}
+
+Tree PopNode(NodeStack *S) {
+    return S->data[--S->top];
+}
+
+/* 显式栈遍历 *************************************** */
+int PreOrder(Tree T,Visitor visit,void *arg) {
+    NodeStack S;
+    if(T == NULL) return 1;
+    if(InitNodeStack(&S) != OK) return -1;
+    int result = 1;
+    PushNode(&S,T);
+    while(S.top && result == 1) {
+        Tree E = PopNode(&S);
+        if(!visit(E,arg)) result = 0;
+        //先右后左，左子树先出栈
+        else if((E->rightChild && PushNode(&S,E->rightChild) != OK) ||
+                (E->leftChild && PushNode(&S,E->leftChild) != OK)) {
+            result = -1;
+        }
+    }
+    FreeNodeStack(&S);
+    return result;
+}
+
+int InOrder(Tree T,Visitor visit,void *arg) {
+    NodeStack S;
+    if(InitNodeStack(&S) != OK) return -1;
+    int result = 1;
+    Tree tree = T;
+    while((tree || S.top) && result == 1) {
+        if(tree) {
+            if(PushNode(&S,tree) != OK) result = -1;
+            tree = tree->leftChild;
+        } else {
+            Tree E = PopNode(&S);
+            if(!visit(E,arg)) result = 0;
+            tree = E->rightChild;
+        }
+    }
+    FreeNodeStack(&S);
+    return result;
+}
+//后序：栈顶的右子树为空或刚访问过(prv)时才访问它
+int PostOrder(Tree T,Visitor visit,void *arg) {
+    NodeStack S;
+    if(InitNodeStack(&S) != OK) return -1;
+    int result = 1;
+    Tree tree = T,prv = NULL;
+    while((tree || S.top) && result == 1) {
+        if(tree) {
+            if(PushNode(&S,tree) != OK) result = -1;
+            tree = tree->leftChild;
+        } else {
+            Tree E = S.data[S.top - 1];
+            if(E->rightChild == NULL || E->rightChild == prv) {
+                if(!visit(E,arg)) result = 0;
+                prv = E;
+                S.top--;
+            } else {
+                tree = E->rightChild;
+            }
+        }
+    }
+    FreeNodeStack(&S);
+    return result;
+}
+//层序：队列用同样的可扩容数组，head之前的位置不再使用
+int LevelOrder(Tree T,Visitor visit,void *arg) {
+    NodeStack Q;
+    if(T == NULL) return 1;
+    if(InitNodeStack(&Q) != OK) return -1;
+    int head = 0,result = 1;
+    PushNode(&Q,T);
+    while(head < Q.top && result == 1) {
+        Tree E = Q.data[head++];
+        if(!visit(E,arg)) result = 0;
+        else if((E->leftChild && PushNode(&Q,E->leftChild) != OK) ||
+                (E->rightChild && PushNode(&Q,E->rightChild) != OK)) {
+            result = -1;
+        }
+    }
+    FreeNodeStack(&Q);
+    return result;
+}
+
+/* Morris遍历 *************************************** */
+//tree的中序前驱：左子树中最右的结点(不含已指回tree的临时指针)
+Tree Predecessor(Tree tree) {
+    Tree pre = tree->leftChild;
+    while(pre->rightChild && pre->rightChild != tree) pre = pre->rightChild;
+    return pre;
+}
+//有左子树时：第一次到达把前驱的右指针指向自己再进左子树，第二次(经临时指针回来)拆掉指针
+//中序在第二次到达时访问，前序在第一次到达时访问
+int MorrisOrder(Tree T,Visitor visit,void *arg,int preorder) {
+    int result = 1;
+    Tree tree = T;
+    while(tree) {
+        if(tree->leftChild == NULL) {
+            if(result == 1 && !visit(tree,arg)) result = 0;
+            tree = tree->rightChild;
+            continue;
+        }
+        Tree pre = Predecessor(tree);
+        if(pre->rightChild == NULL) {
+            if(preorder && result == 1 && !visit(tree,arg)) result = 0;
+            pre->rightChild = tree;
+            tree = tree->leftChild;
+        } else {
+            pre->rightChild = NULL;
+            if(!preorder && result == 1 && !visit(tree,arg)) result = 0;
+            tree = tree->rightChild;
+        }
+    }
+    return result;
+}
+
+int MorrisInOrder(Tree T,Visitor visit,void *arg) {
+    return MorrisOrder(T,visit,arg,0);
+}
+
+int MorrisPreOrder(Tree T,Visitor visit,void *arg) {
+    return MorrisOrder(T,visit,arg,1);
+}
+
+/* 常用访问者与统计 ********************************* */
+int PrintVisitor(Tree node,void *arg) {
+    (void)arg;
+    printf("%c",node->data);
+    return 1;
+}
+
+int CountVisitor(Tree node,void *arg) {
+    (void)node;
+    (*(long*)arg)++;
+    return 1;
+}
+
+int LeafVisitor(Tree node,void *arg) {
+    if(node->leftChild == NULL && node->rightChild == NULL) (*(long*)arg)++;
+    return 1;
+}
+//按序写入缓冲
+typedef struct {
+    char *out;
+    long length;
+} Collector;
+
+int CollectVisitor(Tree node,void *arg) {
+    Collector *C = (Collector*)arg;
+    C->out[C->length++] = node->data;
+    return 1;
+}
+//找到值为key的结点后停止
+typedef struct {
+    ElemTypes key;
+    Tree found;
+    long visited;
+} Finder;
+
+int FindVisitor(Tree node,void *arg) {
+    Finder *F = (Finder*)arg;
+    F->visited++;
+    if(node->data == F->key) {
+        F->found = node;
+        return 0;
+    }
+    return 1;
+}
+
+long NodeCount(Tree T) {
+    long count = 0;
+    MorrisInOrder(T,CountVisitor,&count);
+    return count;
+}
+
+//要看孩子指针，不能用Morris
+long LeafCount(Tree T) {
+    long count = 0;
+    PreOrder(T,LeafVisitor,&count);
+    return count;
+}
+//高度：后序遍历时栈中恰为当前结点的所有祖先
+long Height(Tree T) {
+    NodeStack S;
+    if(T == NULL || InitNodeStack(&S) != OK) return 0;
+    long height = 0;
+    Tree tree = T,prv = NULL;
+    while(tree || S.top) {
+        if(tree) {
+            if(PushNode(&S,tree) != OK) break;
+            if(S.top > height) height = S.top;
+            tree = tree->leftChild;
+        } else {
+            Tree E = S.data[S.top - 1];
+            if(E->rightChild == NULL || E->rightChild == prv) {
+                prv = E;
+                S.top--;
+            } else {
+                tree = E->rightChild;
+            }
+        }
+    }
+    FreeNodeStack(&S);
+    return height;
+}
+
+/* 建树 ********************************************* */
+//同CreateTree的前序串建树，用栈代替递归
+Tree CreateTree(const char *chars) {
+    int length = (int)strlen(chars),top = 0;
+    Tree root = NULL;
+    Tree **slot = (Tree**)malloc(sizeof(Tree*) * (length + 1));
+    slot[top++] = &root;
+    for(int i = 0;top && i < length;i++) {
+        Tree *s = slot[--top];
+        if(chars[i] == '#') {
+            *s = NULL;
+        } else {
+            *s = (Tree)malloc(sizeof(TreeNode));
+            (*s)->data = chars[i];
+            slot[top++] = &(*s)->rightChild;
+            slot[top++] = &(*s)->leftChild;
+        }
+    }
+    free(slot);
+    return root;
+}
+//退化树：shape为'L'全是左孩子，'R'全是右孩子，'Z'左右交替
+Tree CreateChain(long n,char shape) {
+    Tree root = NULL,*slot = &root;
+    for(long i = 0;i < n;i++) {
+        Tree node = (Tree)malloc(sizeof(TreeNode));
+        node->data = (char)('a' + i % 26);
+        node->leftChild = node->rightChild = NULL;
+        *slot = node;
+        slot = shape == 'L' || (shape == 'Z' && i % 2) ? &node->leftChild : &node->rightChild;
+    }
+    return root;
+}
+//后序释放，不递归
+void Destroy(Tree T) {
+    NodeStack S;
+    if(T == NULL || InitNodeStack(&S) != OK) return;
+    PushNode(&S,T);
+    while(S.top) {
+        Tree E = PopNode(&S);
+        if(E->leftChild) PushNode(&S,E->leftChild);
+        if(E->rightChild) PushNode(&S,E->rightChild);
+        free(E);
+    }
+    FreeNodeStack(&S);
+}
+
+double Elapsed(clock_t begin) {
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    //链表二叉树.c中的例子
+    Tree T = CreateTree("AB#CD#E###FG#HI#J####");
+    printf("PreOrder   ");
+    PreOrder(T,PrintVisitor,NULL);
+    printf("\nInOrder    ");
+    InOrder(T,PrintVisitor,NULL);
+    printf("\nPostOrder  ");
+    PostOrder(T,PrintVisitor,NULL);
+    printf("\nLevelOrder ");
+    LevelOrder(T,PrintVisitor,NULL);
+    printf("\nMorris pre ");
+    MorrisPreOrder(T,PrintVisitor,NULL);
+    printf("\nMorris in  ");
+    MorrisInOrder(T,PrintVisitor,NULL);
+    printf("\nHeight = %ld Node Count = %ld Leaf Count = %ld\n",Height(T),NodeCount(T),LeafCount(T));
+    Finder F = {'G',NULL,0};
+    InOrder(T,FindVisitor,&F);
+    printf("Find G in order: %s after %ld nodes\n",F.found ? "found" : "not found",F.visited);
+    Destroy(T);
+
+    //深度10^6的退化树，递归版本会栈溢出
+    printf("\n*******\n");
+    long n = 1000000;
+    const char shapes[] = {'L','R','Z'};
+    char *a = (char*)malloc(n),*b = (char*)malloc(n);
+    for(int k = 0;k < 3;k++) {
+        T = CreateChain(n,shapes[k]);
+        printf("Chain %c n=%ld height=%ld leaves=%ld\n",shapes[k],n,Height(T),LeafCount(T));
+        const char *name[] = {"PreOrder","InOrder","PostOrder","LevelOrder","MorrisPre","MorrisIn"};
+        int (*order[])(Tree,Visitor,void*) = {PreOrder,InOrder,PostOrder,LevelOrder,MorrisPreOrder,MorrisInOrder};
+        for(int i = 0;i < 6;i++) {
+            Collector C = {i >= 4 ? b : a,0};
+            clock_t begin = clock();
+            int result = order[i](T,CollectVisitor,&C);
+            double time = Elapsed(begin);
+            //Morris的结果应与对应的显式栈遍历相同
+            Collector E = {a,0};
+            const char *check = "";
+            if(i >= 4) {
+                (i == 4 ? PreOrder : InOrder)(T,CollectVisitor,&E);
+                check = E.length == C.length && memcmp(a,b,C.length) == 0 ? " OK" : " MISMATCH";
+            }
+            printf("  %-10s %.3fs result %d visited %ld%s\n",name[i],time,result,C.length,check);
+        }
+        //提前终止：中序找到第一个与根同值的结点就停，Morris拆完临时指针后树要恢复原样
+        Finder G = {T->data,NULL,0};
+        long before = NodeCount(T);
+        MorrisInOrder(T,FindVisitor,&G);
+        printf("  Early stop: visited %ld, tree intact %s\n",G.visited,NodeCount(T) == before ? "OK" : "BROKEN");
+        Destroy(T);
+    }
+    free(a);
+    free(b);
+    return 0;
+}
@@ -0,0 +1,566 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../IndexTree.h"
+/*
+可扩容的顺序二叉树
+顺序二叉树.c的Tree是定长ElemType[MAX_TREE_SIZE]；链表二叉树.c的PrintTransfer按高度开2^height个位置，
+链状的树高度几十就放不下了
+这里：
+1 结点仍按层序编号(0号为根，i的孩子2i+1、2i+2，双亲(i-1)/2)，编号到存储位置的映射由布局决定
+2 树高不够时整层扩容：层序布局realloc后补一层空位，编号和位置都不变
+3 vEB布局：高h的树切成上半高h/2的顶树和下面2^(h/2)棵底树，依次存放，每棵再递归地切
+  从根往下走时，无论缓存块多大，连续的若干层都落在同一块里(cache-oblivious)
+  每个深度d只会在一次切分中成为底树的根，预先记下该次切分的顶树大小top[d]、底树大小bottom[d]、
+  顶树根的深度rootDepth[d]，则 pos[d] = pos[rootDepth[d]] + top[d] + (i & top[d]) * bottom[d]
+  (i为从1开始的层序编号)。游标保存路径上每层的位置，走向孩子、双亲都是O(1)
+4 稀疏：链状的树结点少而编号大，按编号存进散列表，只占O(结点数)空间；编号用64位，树高不超过64
+5 更深的树没有能用整数表示的层序编号，TransferAuto退回IndexTree.h的结点池，孩子用显式下标
+*/
+#define OK 1
+#define ERROR 0
+#define LAYOUT_BFS 0
+#define LAYOUT_VEB 1
+#define MAX_HEIGHT 64
+#define MAX_DENSE_HEIGHT 30
+#define SPARSE_RATIO 8 // 满二叉树的位置数超过结点数的这么多倍时改用稀疏存储
+
+typedef int Status;
+typedef int ElemType;
+
+ElemType Nil = 0; //以0为空
+
+typedef struct {
+    long long top[MAX_HEIGHT]; // 顶树结点数，也是求底树序号的掩码
+    long long bottom[MAX_HEIGHT]; // 底树结点数
+    int rootDepth[MAX_HEIGHT]; // 顶树根的深度
+} VebTable;
+
+typedef struct {
+    ElemType *data;
+    int height; // 层数
+    long long capacity; // 2^height-1
+    long long count; // 非空结点数
+    int layout;
+    VebTable table;
+} ImplicitTree;
+
+typedef struct {
+    long long index; // 层序编号，从0开始
+    int depth;
+    long long pos[MAX_HEIGHT]; // 路径上各层结点的存储位置
+} Cursor;
+
+/* 编号与布局 *************************************** */
+int Depth(long long i) {
+    return 63 - __builtin_clzll((unsigned long long)i + 1);
+}
+
+long long ParentIndex(long long i) {
+    return (i - 1) / 2;
+}
+
+long long ChildIndex(long long i,int right) {
+    return 2 * i + 1 + right;
+}
+//高为h、根在深度r的子树的切分
+void SplitVeb(VebTable *V,int r,int h) {
+    if(h <= 1) return;
+    int topHeight = h / 2,bottomHeight = h - topHeight,d = r + topHeight;
+    V->top[d] = (1LL << topHeight) - 1;
+    V->bottom[d] = (1LL << bottomHeight) - 1;
+    V->rootDepth[d] = r;
+    SplitVeb(V,r,topHeight);
+    SplitVeb(V,d,bottomHeight);
+}
+//深度d的结点(从1开始的编号i1)在已知路径位置pos[0..d-1]时的位置
+long long VebStep(const VebTable *V,const long long *pos,long long i1,int d) {
+    return d == 0 ? 0 : pos[V->rootDepth[d]] + V->top[d] + (i1 & V->top[d]) * V->bottom[d];
+}
+
+long long VebPosition(const VebTable *V,long long i) {
+    long long pos[MAX_HEIGHT],i1 = i + 1;
+    int depth = Depth(i);
+    for(int d = 0;d <= depth;d++) pos[d] = VebStep(V,pos,i1 >> (depth - d),d);
+    return pos[depth];
+}
+
+long long Position(const ImplicitTree *T,long long i) {
+    return T->layout == LAYOUT_BFS ? i : VebPosition(&T->table,i);
+}
+
+/* 容器 ********************************************* */
+Status InitImplicit(ImplicitTree *T,int layout) {
+    T->layout = layout;
+    T->height = 0;
+    T->capacity = T->count = 0;
+    T->data = NULL;
+    memset(&T->table,0,sizeof(VebTable));
+    return OK;
+}
+
+void DestroyImplicit(ImplicitTree *T) {
+    free(T->data);
+    InitImplicit(T,T->layout);
+}
+//扩到height层。vEB布局换了高度切分就变了，要按编号整体搬一遍，每个结点重算位置O(height)，
+//翻倍扩容下每个结点均摊被搬O(1)次，即均摊O(height)
+Status GrowImplicit(ImplicitTree *T,int height) {
+    if(height <= T->height) return OK;
+    if(height > MAX_DENSE_HEIGHT) return ERROR;
+    long long capacity = (1LL << height) - 1;
+    if(T->layout == LAYOUT_BFS) {
+        ElemType *grown = (ElemType*)realloc(T->data,sizeof(ElemType) * capacity);
+        if(!grown) return ERROR;
+        for(long long i = T->capacity;i < capacity;i++) grown[i] = Nil;
+        T->data = grown;
+    } else {
+        ElemType *grown = (ElemType*)malloc(sizeof(ElemType) * capacity);
+        if(!grown) return ERROR;
+        VebTable V;
+        memset(&V,0,sizeof(VebTable));
+        SplitVeb(&V,0,height);
+        for(long long i = 0;i < capacity;i++) grown[i] = Nil;
+        for(long long i = 0;i < T->capacity;i++) grown[VebPosition(&V,i)] = T->data[VebPosition(&T->table,i)];
+        free(T->data);
+        T->data = grown;
+        T->table = V;
+    }
+    T->height = height;
+    T->capacity = capacity;
+    return OK;
+}
+
+ElemType GetNode(const ImplicitTree *T,long long i) {
+    return i < T->capacity ? T->data[Position(T,i)] : Nil;
+}
+//同Create的检查：非空结点必须有双亲
+Status SetNode(ImplicitTree *T,long long i,ElemType e) {
+    if(i != 0 && e != Nil && GetNode(T,ParentIndex(i)) == Nil) return ERROR;
+    if(i >= T->capacity) {
+        if(e == Nil) return OK;
+        if(!GrowImplicit(T,Depth(i) + 1)) return ERROR;
+    }
+    ElemType *slot = &T->data[Position(T,i)];
+    T->count += (e != Nil) - (*slot != Nil);
+    *slot = e;
+    return OK;
+}
+
+/* 游标 ********************************************* */
+Status CursorRoot(const ImplicitTree *T,Cursor *C) {
+    C->index = 0;
+    C->depth = 0;
+    C->pos[0] = 0;
+    return T->capacity > 0 && T->data[0] != Nil;
+}
+
+ElemType CursorValue(const ImplicitTree *T,const Cursor *C) {
+    return T->data[C->pos[C->depth]];
+}
+//孩子存在才移动过去
+Status CursorChild(const ImplicitTree *T,Cursor *C,int right) {
+    long long child = ChildIndex(C->index,right);
+    if(child >= T->capacity) return ERROR;
+    int d = C->depth + 1;
+    long long pos = T->layout == LAYOUT_BFS ? child : VebStep(&T->table,C->pos,child + 1,d);
+    if(T->data[pos] == Nil) return ERROR;
+    C->index = child;
+    C->depth = d;
+    C->pos[d] = pos;
+    return OK;
+}
+
+Status CursorParent(Cursor *C) {
+    if(C->depth == 0) return ERROR;
+    C->index = ParentIndex(C->index);
+    C->depth--;
+    return OK;
+}
+//前序：只用游标，回溯靠CursorParent，不需要栈
+long long ImplicitHead(const ImplicitTree *T,ElemType *out) {
+    Cursor C;
+    long long n = 0;
+    if(!CursorRoot(T,&C)) return 0;
+    while(1) {
+        ElemType e = CursorValue(T,&C);
+        if(out) out[n] = e;
+        else printf("%d ",e);
+        n++;
+        if(CursorChild(T,&C,0) || CursorChild(T,&C,1)) continue;
+        //向上找第一个从左边上来且有右孩子的祖先
+        int moved = 0;
+        while(!moved && C.depth > 0) {
+            int fromLeft = C.index % 2 == 1;
+            CursorParent(&C);
+            moved = fromLeft && CursorChild(T,&C,1);
+        }
+        if(!moved) break;
+    }
+    return n;
+}
+
+/* 稀疏存储 ***************************************** */
+typedef struct {
+    unsigned long long *key; // 编号+1，0为空位
+    ElemType *value;
+    long long capacity; // 2的幂
+    long long count;
+} SparseTree;
+
+Status InitSparse(SparseTree *S,long long expect) {
+    S->capacity = 16;
+    while(S->capacity < expect * 2) S->capacity *= 2;
+    S->key = (unsigned long long*)calloc(S->capacity,sizeof(unsigned long long));
+    S->value = (ElemType*)malloc(sizeof(ElemType) * S->capacity);
+    S->count = 0;
+    return S->key && S->value ? OK : ERROR;
+}
+
+void DestroySparse(SparseTree *S) {
+    free(S->key);
+    free(S->value);
+    S->key = NULL;
+    S->value = NULL;
+    S->capacity = S->count = 0;
+}
+
+long long SparseSlot(const SparseTree *S,unsigned long long key) {
+    long long mask = S->capacity - 1,h = (long long)((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+    while(S->key[h] != 0 && S->key[h] != key) h = (h + 1) & mask;
+    return h;
+}
+
+Status SparsePut(SparseTree *S,unsigned long long i,ElemType e) {
+    if((S->count + 1) * 2 > S->capacity) {
+        SparseTree grown;
+        if(!InitSparse(&grown,S->capacity)) return ERROR;
+        for(long long k = 0;k < S->capacity;k++) {
+            if(S->key[k] == 0) continue;
+            long long h = SparseSlot(&grown,S->key[k]);
+            grown.key[h] = S->key[k];
+            grown.value[h] = S->value[k];
+        }
+        grown.count = S->count;
+        DestroySparse(S);
+        *S = grown;
+    }
+    long long h = SparseSlot(S,i + 1);
+    if(S->key[h] == 0) {
+        S->key[h] = i + 1;
+        S->count++;
+    }
+    S->value[h] = e;
+    return OK;
+}
+
+ElemType SparseGet(const SparseTree *S,unsigned long long i) {
+    long long h = SparseSlot(S,i + 1);
+    return S->key[h] ? S->value[h] : Nil;
+}
+
+/* 链表二叉树转换 *********************************** */
+typedef struct TreeNode {
+    char data;
+    struct TreeNode *leftChild,*rightChild;
+} TreeNode,*Tree;
+
+typedef struct {
+    Tree node;
+    unsigned long long index;
+    int depth;
+} Frame;
+//高度和结点数，显式栈
+int MeasureLinked(Tree L,long long *numNodes) {
+    Frame *stack = NULL;
+    int top = 0,capacity = 0,height = 0;
+    *numNodes = 0;
+    if(L) {
+        capacity = 64;
+        stack = (Frame*)malloc(sizeof(Frame) * capacity);
+        stack[top++] = (Frame){L,0,1};
+    }
+    while(top) {
+        Frame f = stack[--top];
+        (*numNodes)++;
+        if(f.depth > height) height = f.depth;
+        if(top + 2 > capacity) {
+            capacity *= 2;
+            stack = (Frame*)realloc(stack,sizeof(Frame) * capacity);
+        }
+        if(f.node->rightChild) stack[top++] = (Frame){f.node->rightChild,0,f.depth + 1};
+        if(f.node->leftChild) stack[top++] = (Frame){f.node->leftChild,0,f.depth + 1};
+    }
+    free(stack);
+    return height;
+}
+//把L按层序编号写入D或S(恰有一个非空)
+Status FillFromLinked(Tree L,ImplicitTree *D,SparseTree *S,long long numNodes) {
+    Frame *stack = (Frame*)malloc(sizeof(Frame) * (numNodes + 1));
+    int top = 0;
+    Status ok = OK;
+    if(L) stack[top++] = (Frame){L,0,0};
+    while(top && ok) {
+        Frame f = stack[--top];
+        ok = D ? SetNode(D,(long long)f.index,f.node->data) : SparsePut(S,f.index,f.node->data);
+        if(f.node->rightChild) stack[top++] = (Frame){f.node->rightChild,2 * f.index + 2,0};
+        if(f.node->leftChild) stack[top++] = (Frame){f.node->leftChild,2 * f.index + 1,0};
+    }
+    free(stack);
+    return ok;
+}
+//树太深时按前序复制进结点池X，孩子用下标，不需要层序编号
+//栈里同时记下新结点要挂到哪里：双亲下标*2+是否右孩子，根为-1
+Status FillIndexTree(Tree L,IndexTree *X,long long numNodes) {
+    if(numNodes >= 0x7fffffff || !InitIndexTree(X,(int)numNodes)) return ERROR;
+    Tree *stack = (Tree*)malloc(sizeof(Tree) * (numNodes + 1));
+    int *link = (int*)malloc(sizeof(int) * (numNodes + 1)),top = 0;
+    Status ok = stack && link ? OK : ERROR;
+    if(L && ok) {
+        stack[top] = L;
+        link[top++] = -1;
+    }
+    while(top && ok) {
+        Tree p = stack[--top];
+        int at = link[top],i = NewIndexNode(X,p->data);
+        if(i == NIL) {
+            ok = ERROR;
+            break;
+        }
+        if(at < 0) X->root = i;
+        else if(at % 2) X->node[at / 2].rightChild = i;
+        else X->node[at / 2].leftChild = i;
+        if(p->rightChild) {
+            stack[top] = p->rightChild;
+            link[top++] = 2 * i + 1;
+        }
+        if(p->leftChild) {
+            stack[top] = p->leftChild;
+            link[top++] = 2 * i;
+        }
+    }
+    free(stack);
+    free(link);
+    if(!ok) DestroyIndexTree(X);
+    return ok;
+}
+//代替PrintTransfer：位置数不超过结点数的SPARSE_RATIO倍时稠密存储，否则稀疏，超过64层时用结点池
+//返回1为稠密(D)，2为稀疏(S)，3为结点池(X)，0为内存不足
+int TransferAuto(Tree L,ImplicitTree *D,SparseTree *S,IndexTree *X) {
+    long long numNodes;
+    int height = MeasureLinked(L,&numNodes);
+    if(height <= MAX_DENSE_HEIGHT && (1LL << height) - 1 <= SPARSE_RATIO * numNodes + 64) {
+        if(!GrowImplicit(D,height) || !FillFromLinked(L,D,NULL,numNodes)) return 0;
+        return 1;
+    }
+    if(height > MAX_HEIGHT) return FillIndexTree(L,X,numNodes) ? 3 : 0;
+    if(!InitSparse(S,numNodes) || !FillFromLinked(L,NULL,S,numNodes)) return 0;
+    return 2;
+}
+
+/* 演示 ********************************************* */
+//同 下标二叉树(连续结点池).c 的CreateLinkedTree
+Tree CreateLinkedTree(const char *chars,int length) {
+    Tree root = NULL;
+    Tree **slot = (Tree**)malloc(sizeof(Tree*) * (length + 1));
+    int top = 0;
+    slot[top++] = &root;
+    for(int i = 0;top && i < length;i++) {
+        Tree *s = slot[--top];
+        if(chars[i] == '#') {
+            *s = NULL;
+        } else {
+            *s = (Tree)malloc(sizeof(TreeNode));
+            (*s)->data = chars[i];
+            slot[top++] = &(*s)->rightChild;
+            slot[top++] = &(*s)->leftChild;
+        }
+    }
+    free(slot);
+    return root;
+}
+
+void DestroyLinkedTree(Tree T) {
+    Tree *stack = (Tree*)malloc(sizeof(Tree) * 64);
+    int top = 0,capacity = 64;
+    if(T) stack[top++] = T;
+    while(top) {
+        Tree p = stack[--top];
+        if(top + 2 > capacity) {
+            capacity *= 2;
+            stack = (Tree*)realloc(stack,sizeof(Tree) * capacity);
+        }
+        if(p->leftChild) stack[top++] = p->leftChild;
+        if(p->rightChild) stack[top++] = p->rightChild;
+        free(p);
+    }
+    free(stack);
+}
+//二叉排序树查找：满二叉树按中序填1..n，从根往下比较
+long long Search(const ImplicitTree *T,ElemType key) {
+    Cursor C;
+    if(!CursorRoot(T,&C)) return -1;
+    while(1) {
+        ElemType e = CursorValue(T,&C);
+        if(e == key) return C.index;
+        if(!CursorChild(T,&C,key > e)) return -1;
+    }
+}
+//不经过游标的查找：层序布局只算编号，vEB布局在局部数组里记路径位置
+long long SearchBfs(const ImplicitTree *T,ElemType key) {
+    long long i = 0;
+    while(i < T->capacity) {
+        ElemType e = T->data[i];
+        if(e == Nil) return -1;
+        if(e == key) return i;
+        i = 2 * i + 1 + (key > e);
+    }
+    return -1;
+}
+
+long long SearchVeb(const ImplicitTree *T,ElemType key) {
+    long long pos[MAX_HEIGHT],i1 = 1;
+    pos[0] = 0;
+    for(int d = 0;d < T->height;) {
+        ElemType e = T->data[pos[d]];
+        if(e == Nil) return -1;
+        if(e == key) return i1 - 1;
+        i1 = 2 * i1 + (key > e);
+        if(++d < T->height) pos[d] = VebStep(&T->table,pos,i1,d);
+    }
+    return -1;
+}
+
+unsigned Rand32() {
+    return (unsigned)rand() * 32768u + rand();
+}
+
+double Elapsed(clock_t begin) {
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+int main() {
+    //顺序二叉树.c的Create：层序1..10
+    for(int layout = LAYOUT_BFS;layout <= LAYOUT_VEB;layout++) {
+        ImplicitTree T;
+        InitImplicit(&T,layout);
+        for(int i = 0;i < 10;i++) SetNode(&T,i,i + 1);
+        printf("%s Head: ",layout == LAYOUT_BFS ? "BFS" : "vEB");
+        ImplicitHead(&T,NULL);
+        printf(" storage:");
+        for(long long k = 0;k < T.capacity;k++) printf(" %d",T.data[k]);
+        printf("\n");
+        DestroyImplicit(&T);
+    }
+    //链表二叉树.c的例子，按PrintTransfer的格式输出
+    const char *example = "AB#CD#E###FG#HI#J####";
+    Tree L = CreateLinkedTree(example,(int)strlen(example));
+    ImplicitTree D;
+    SparseTree S;
+    IndexTree X;
+    InitImplicit(&D,LAYOUT_BFS);
+    printf("Transfer %s -> %d: ",example,TransferAuto(L,&D,&S,&X));
+    for(long long k = 0;k < D.capacity;k++) printf("%c",D.data[k] == Nil ? '#' : (char)D.data[k]);
+    printf("\n");
+    DestroyImplicit(&D);
+    DestroyLinkedTree(L);
+    //偏斜的树：右链长48，每个链结点再挂一个左孩子
+    char skew[48 * 4 + 2];
+    int length = 0;
+    for(int k = 0;k < 48;k++) {
+        skew[length++] = (char)('a' + k % 26);
+        skew[length++] = (char)('A' + k % 26);
+        skew[length++] = '#';
+        skew[length++] = '#';
+    }
+    skew[length++] = '#';
+    L = CreateLinkedTree(skew,length);
+    InitImplicit(&D,LAYOUT_BFS);
+    int kind = TransferAuto(L,&D,&S,&X);
+    printf("Skewed height 49, 96 nodes -> %s",kind == 2 ? "sparse" : kind == 1 ? "dense" : "failed");
+    if(kind == 2) {
+        //沿右链往下走到底
+        unsigned long long i = 0;
+        int depth = 0;
+        while(SparseGet(&S,2 * i + 2) != Nil) {
+            i = 2 * i + 2;
+            depth++;
+        }
+        printf(" %lld entries (dense would need 2^49-1), last right-spine node %c at depth %d",S.count,
+               (char)SparseGet(&S,i),depth);
+        DestroySparse(&S);
+    }
+    printf("\n");
+    DestroyImplicit(&D);
+    DestroyLinkedTree(L);
+    //更深的链无法用64位层序编号，退回结点池
+    int chain = 100000;
+    char *chars = (char*)malloc(chain * 2 + 2);
+    length = 0;
+    for(int k = 0;k < chain;k++) {
+        chars[length++] = 'X';
+        chars[length++] = '#';
+    }
+    chars[length++] = '#';
+    L = CreateLinkedTree(chars,length);
+    InitImplicit(&D,LAYOUT_BFS);
+    kind = TransferAuto(L,&D,&S,&X);
+    printf("Chain of %d nodes -> %s",chain,kind == 3 ? "index pool" : "failed");
+    if(kind == 3) {
+        printf(", %d nodes height %d",NodeCount(&X),Height(&X));
+        DestroyIndexTree(&X);
+    }
+    printf("\n");
+    DestroyImplicit(&D);
+    DestroyLinkedTree(L);
+    free(chars);
+
+    //二叉排序树查找：层序布局与vEB布局
+    printf("\n*******\n");
+    srand(2024);
+    int height = 25,queries = 2000000;
+    long long n = (1LL << height) - 1;
+    ElemType *keys = (ElemType*)malloc(sizeof(ElemType) * queries);
+    for(int q = 0;q < queries;q++) keys[q] = (ElemType)(Rand32() % n) + 1;
+    long long found[2] = {0,0};
+    for(int layout = LAYOUT_BFS;layout <= LAYOUT_VEB;layout++) {
+        ImplicitTree T;
+        InitImplicit(&T,layout);
+        clock_t begin = clock();
+        GrowImplicit(&T,height);
+        //深度d、本层第k个结点的中序序号为(2k+1)*2^(height-1-d)
+        for(long long i = 0;i < n;i++) {
+            int d = Depth(i);
+            long long k = i + 1 - (1LL << d);
+            T.data[Position(&T,i)] = (ElemType)((2 * k + 1) << (height - 1 - d));
+        }
+        T.count = n;
+        double build = Elapsed(begin);
+        begin = clock();
+        long long sum = 0;
+        for(int q = 0;q < queries;q++) sum += Search(&T,keys[q]);
+        double cursorTime = Elapsed(begin);
+        found[layout] = sum;
+        printf("%s height %d (%.0f MB) fill %.3fs %d searches via cursor %.3fs",layout == LAYOUT_BFS ? "BFS" : "vEB",
+               height,n * (double)sizeof(ElemType) / 1048576,build,queries,cursorTime);
+        begin = clock();
+        long long check = 0;
+        for(int q = 0;q < queries;q++) check += layout == LAYOUT_BFS ? SearchBfs(&T,keys[q]) : SearchVeb(&T,keys[q]);
+        printf(", direct %.3fs%s",Elapsed(begin),check == sum ? "" : " MISMATCH");
+        printf("\n");
+        DestroyImplicit(&T);
+    }
+    printf("same results: %s\n",found[0] == found[1] ? "OK" : "MISMATCH");
+    //逐个插入触发扩容
+    for(int layout = LAYOUT_BFS;layout <= LAYOUT_VEB;layout++) {
+        ImplicitTree T;
+        InitImplicit(&T,layout);
+        clock_t begin = clock();
+        for(long long i = 0;i < (1LL << 20) - 1;i++) SetNode(&T,i,(ElemType)(i + 1));
+        printf("%s grow by SetNode to %lld nodes %.3fs\n",layout == LAYOUT_BFS ? "BFS" : "vEB",T.count,Elapsed(begin));
+        DestroyImplicit(&T);
+    }
+    free(keys);
+    return 0;
+}
@@ -1,3 +1,4 @@
+//完整的非递归遍历(可扩容栈、Morris、访问者回调与提前终止)见 进阶补充题/遍历引擎(显式栈 Morris 访问者).c
 void GetHead(Tree T) {
     Push(T);
     while(!isEmpty(S)) {
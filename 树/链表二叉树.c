@@ -16,6 +16,7 @@ typedef struct TreeNode {
     ElemTypes data;
     struct TreeNode *leftChild,*rightChild;
 } TreeNode,*Tree;
+//结点放在连续数组、孩子用下标的版本见 IndexTree.h 与 进阶补充题/下标二叉树(连续结点池).c
 
 Status Init(Tree *T) {
     (*T) = NULL;
@@ -200,6 +201,7 @@ void Transfer(Tree T,int i,char *S) {
         Transfer(T->rightChild,2*i + 2,S);
     }
 }
+//按高度开2^height个位置，偏斜的树会放不下；自动改用稀疏存储的TransferAuto见 进阶补充题/顺序二叉树(可扩容 vEB布局 稀疏).c
 void PrintTransfer(Tree T) {
     // 计算顺序存储需要的容量 根据二叉树性质和高度
     int count = 0;
@@ -290,6 +292,7 @@ Status isEmpty(Queue Q) {
     }
 }
 //层序遍历
+//队列定长MAXSIZE，宽树会溢出；可扩容环形队列、逐层回调、并行按层展开的版本见 进阶补充题/层序遍历引擎(环形队列 逐层回调 并行扩展).c
 void GetLayer(Tree T) {
     if (T == NULL) {
         return;
@@ -469,6 +472,7 @@ Status GetMiddleWithNum(Tree T) {
     return MiddleWithNum(T, &num);
 }
 
+//每次查询都搜整棵树；建一次索引后O(1)查询的版本见 进阶补充题/最近公共祖先(DFS序 稀疏表).c
 Tree SearchPublicParent(Tree T, Tree I, Tree J) {
     if (T == NULL || T == I || T == J) {
         return T;
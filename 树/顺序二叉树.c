@@ -11,6 +11,7 @@
 typedef int Status;
 typedef int ElemType;
 typedef ElemType Tree[MAX_TREE_SIZE];
+//可扩容、可选vEB布局、偏斜树用稀疏存储的版本见 进阶补充题/顺序二叉树(可扩容 vEB布局 稀疏).c
  /* 0号单元存储根结点  */
 typedef struct {
 	int level,order; 